@@ -0,0 +1,105 @@
+/******************************************************************************
+ * Copyright (C) 2025 by Albert Olszewski
+ *
+ * Redistribution, modification or use of this software in source or binary
+ * forms is permitted as long as the files maintain this copyright. Users are
+ * permitted to modify this and use it to learn about the field of embedded
+ * software. Alex Fosdick and the University of Colorado are not liable for any
+ * misuse of this material.
+ *
+ *****************************************************************************/
+/**
+ * @file arena.h
+ * @brief Arena (bump) allocator for short lived buffers
+ *
+ * This header file provides an allocator over a region the caller owns.
+ * Allocating moves an offset forward; nothing is freed on its own.
+ * Instead the offset is saved with arena_mark and everything allocated
+ * after it is released at once with arena_reset_to, for example at the
+ * end of each frame.
+ *
+ * An arena is not locked; use one per thread.
+ *
+ * @author Albert Olszewski
+ * @date October 17, 2026
+ *
+ */
+#ifndef __ARENA_H__
+#define __ARENA_H__
+
+#include <stdint.h>
+#include <stdlib.h>
+
+/**
+ * @brief An arena over a caller supplied region
+ */
+typedef struct {
+  uint8_t * base;
+  size_t size;
+  size_t used;
+} arena_t;
+
+/**
+ * @brief A saved position of an arena, see arena_mark
+ */
+typedef size_t arena_mark_t;
+
+/**
+ * @brief Sets up an arena over a region
+ *
+ * The region is not touched and must outlive the arena.
+ *
+ * @param arena Pointer to the arena to set up
+ * @param region Pointer to the memory to allocate from
+ * @param size Size of the region in bytes
+ *
+ * @return void
+ */
+void arena_init(arena_t * arena, uint8_t * region, size_t size);
+
+/**
+ * @brief Allocates from an arena
+ *
+ * @param arena Pointer to the arena
+ * @param length Number of bytes needed
+ * @param alignment Required alignment in bytes, a power of two
+ *
+ * @return Pointer to the memory, or NULL if the arena has no room left or
+ * alignment is not a power of two.
+ */
+void * arena_alloc(arena_t * arena, size_t length, size_t alignment);
+
+/**
+ * @brief Saves the current position of an arena
+ *
+ * @param arena Pointer to the arena
+ *
+ * @return The position, to pass to arena_reset_to.
+ */
+arena_mark_t arena_mark(const arena_t * arena);
+
+/**
+ * @brief Releases everything allocated since a mark
+ *
+ * Memory allocated after the mark must not be used afterwards. A mark of 0
+ * empties the arena.
+ *
+ * @param arena Pointer to the arena
+ * @param mark Position from arena_mark
+ *
+ * @return void
+ */
+void arena_reset_to(arena_t * arena, arena_mark_t mark);
+
+/**
+ * @brief Returns the bytes an arena has left
+ *
+ * Alignment padding may make a request of this size fail.
+ *
+ * @param arena Pointer to the arena
+ *
+ * @return Bytes not yet allocated.
+ */
+size_t arena_remaining(const arena_t * arena);
+
+#endif /* __ARENA_H__ */
@@ -0,0 +1,191 @@
+/******************************************************************************
+ * Copyright (C) 2025 by Albert Olszewski
+ *
+ * Redistribution, modification or use of this software in source or binary
+ * forms is permitted as long as the files maintain this copyright. Users are
+ * permitted to modify this and use it to learn about the field of embedded
+ * software. Alex Fosdick and the University of Colorado are not liable for any
+ * misuse of this material.
+ *
+ *****************************************************************************/
+/**
+ * @file bench.h
+ * @brief Throughput benchmarks
+ *
+ * This header file provides small benchmarks of the data functions. They
+ * are built and run from main when compiling with -DBENCH (make BENCH=1).
+ * Time is measured in nanoseconds on HOST and in core cycles on MSP432.
+ * Results are printed and also kept in bench_results, which is where to
+ * read them on MSP432, where PRINTF prints nothing.
+ *
+ * @author Albert Olszewski
+ * @date October 17, 2026
+ *
+ */
+#ifndef __BENCH_H__
+#define __BENCH_H__
+
+#include <stdint.h>
+#include <stdlib.h>
+
+/* Buffer size in words; the MSP432 has 64 KiB of SRAM in all */
+#if defined (MSP432)
+#define BENCH_SIZE_W  (512)
+#else
+#define BENCH_SIZE_W  (16384)
+#endif
+#define BENCH_SIZE_B  (BENCH_SIZE_W * 4)
+#define BENCH_ROUNDS  (256)
+#define BENCH_FRAMES  (4096)
+#define BENCH_FRAME_BUFFERS (16)
+/* Largest buffer of an allocation frame in words, so that a whole frame
+ * fits in BENCH_SIZE_W */
+#if (BENCH_SIZE_W / BENCH_FRAME_BUFFERS) < 256
+#define BENCH_FRAME_WORDS   (BENCH_SIZE_W / BENCH_FRAME_BUFFERS)
+#else
+#define BENCH_FRAME_WORDS   (256)
+#endif
+#define BENCH_STRESS_OPS    (100000)
+#define BENCH_STRESS_SLOTS  (64)
+
+/* The MSP432 cycle counter is 32 bits wide; differences stay correct
+ * across a single wrap. */
+#if defined (MSP432)
+typedef uint32_t bench_tick_t;
+#else
+typedef uint64_t bench_tick_t;
+#endif
+
+/**
+ * @brief One benchmark result
+ *
+ * value is in the unit the report prints: MB/s or ns/op on HOST,
+ * cycles/100B or cycles/op on MSP432. worst is the slowest single
+ * operation in ns or cycles, from bench_report_worst, and 0 otherwise.
+ */
+typedef struct {
+  const char * name;
+  uint32_t value;
+  uint32_t worst;
+} bench_result_t;
+
+#define BENCH_RESULTS_MAX (32)
+
+/* Every reported result in order, for a debugger to read; results past
+ * BENCH_RESULTS_MAX are printed only */
+extern volatile bench_result_t bench_results[BENCH_RESULTS_MAX];
+extern volatile uint32_t bench_result_count;
+
+/**
+ * @brief Reads the benchmark clock
+ *
+ * Nanoseconds from a monotonic clock on HOST, the DWT cycle counter on
+ * MSP432. Only the difference between two readings is meaningful.
+ *
+ * @return The current tick count.
+ */
+bench_tick_t bench_ticks(void);
+
+/**
+ * @brief Prints the throughput of one benchmark
+ *
+ * The result is also added to bench_results.
+ *
+ * @param name Name of the benchmark
+ * @param bytes Number of bytes processed
+ * @param ticks Ticks it took, see bench_ticks
+ *
+ * @return void
+ */
+void bench_report(const char * name, uint64_t bytes, bench_tick_t ticks);
+
+/**
+ * @brief Prints the average cost of one operation
+ *
+ * The result is also added to bench_results.
+ *
+ * @param name Name of the benchmark
+ * @param ops Number of operations timed
+ * @param ticks Ticks they took, see bench_ticks
+ *
+ * @return void
+ */
+void bench_report_ops(const char * name, uint64_t ops, bench_tick_t ticks);
+
+/**
+ * @brief Prints the average and worst time of one operation
+ *
+ * The result is also added to bench_results.
+ *
+ * @param name Name of the benchmark
+ * @param ops Number of operations timed
+ * @param ticks Ticks they took in total, see bench_ticks
+ * @param worst Ticks the slowest of them took
+ *
+ * @return void
+ */
+void bench_report_worst(const char * name, uint64_t ops, bench_tick_t ticks, bench_tick_t worst);
+
+/**
+ * @brief Benchmarks the CRC functions
+ *
+ * Measures CRC-32 and CRC-32C over a 64 KiB buffer with every
+ * implementation the platform has.
+ *
+ * @return void
+ */
+void bench_crc(void);
+
+/**
+ * @brief Benchmarks the hash function
+ *
+ * Measures hash64 over a 64 KiB buffer next to my_memcopy within the same
+ * buffer, the memory bandwidth the hash should come close to.
+ *
+ * @return void
+ */
+void bench_hash(void);
+
+/**
+ * @brief Benchmarks byte translation through a table
+ *
+ * Times my_memxlat with the scalar kernels and with the widest kernels
+ * the cpu supports.
+ *
+ * @return void
+ */
+void bench_xlat(void);
+
+/**
+ * @brief Benchmarks allocation of short lived buffers
+ *
+ * Each frame takes BENCH_FRAME_BUFFERS buffers of 1 to BENCH_FRAME_WORDS
+ * words and gives them back, once with reserve_words and free_words and
+ * once from an arena reset at the end of the frame. reserve_words calls
+ * that fail are skipped and their number reported.
+ *
+ * @return void
+ */
+void bench_alloc(void);
+
+/**
+ * @brief Benchmarks the worst case of the TLSF allocator
+ *
+ * Runs BENCH_STRESS_OPS random allocations and frees of mixed sizes over
+ * BENCH_STRESS_SLOTS slots, timing every call, once with tlsf_alloc and
+ * tlsf_free (where tlsf.c is built) and once with malloc and free. What
+ * matters for real-time code is the slowest call, not the average; on
+ * MSP432 read it from bench_results.
+ *
+ * @return void
+ */
+void bench_tlsf(void);
+
+/**
+ * @brief Runs all benchmarks
+ *
+ * @return void
+ */
+void bench(void);
+
+#endif /* __BENCH_H__ */
@@ -25,11 +25,37 @@
 #define MEM_SET_SIZE_B  (32)
 #define MEM_SET_SIZE_W  (8)
 #define MEM_ZERO_LENGTH (16)
+#define MEM_WIDE_SIZE_W (64)
+#define MEM_WIDE_SIZE_B (256)
+#define MEM_WIDE_OFFSETS (16)
+#define MEM_WIDE_LENGTH (160)
+#define MEM_MT_SIZE_W   (16384)
+#define MEM_MT_SIZE_B   (65536)
+#define MEM_MT_THREADS_TEST (5)
+#define MEM_PATTERN_MAX (20)
+#define MEM_XLAT_TABLE_SIZE (256)
+#define MEM_CHANNELS_MAX (5)
+#define MEM_PLANE_SIZE_B (48)
+#define MEM_SEGMENT_COUNT (20)
+#define MEM_ASYNC_STRIDE  (8192)
+#define MEM_ALIGN_MAX     (4096)
+#define MEM_POOL_BLOCKS   (64)
+#define MEM_ARENA_SIZE_B  (4096)
+#define MEM_SLAB_OBJECTS  (1000)
+#define MEM_SLAB_THREADS  (4)
+#define MEM_TLSF_SLOTS    (64)
+#define MEM_TLSF_OPS      (4000)
+#define CRC32_CHECK       (0xCBF43926u)
+#define CRC32C_CHECK      (0xE3069283u)
+#define ADLER32_WIKIPEDIA (0x11E60398u)
+#define HASH64_EMPTY      (0xEF46DB3751D8E999ull)
+#define HASH64_ABC        (0x44BC2CF5AD770999ull)
+#define HASH64_SPAM       (0xFBCEA83C8A378BF1ull)
 
 #define TEST_MEMMOVE_LENGTH (16)
 #define TEST_ERROR          (1)
 #define TEST_NO_ERROR       (0)
-#define TESTCOUNT           (8)
+#define TESTCOUNT           (30)
 
 /**
  * @brief function to run course1 materials
@@ -127,5 +153,270 @@ int8_t test_memset();
  */
 int8_t test_reverse();
 
+/**
+ * @brief function to test memmove and memcopy at every misalignment
+ * 
+ * This function calls my_memmove and my_memcopy for every combination of
+ * source and destination offset within a word and a range of lengths,
+ * overlapping in both directions, and compares against a byte at a time
+ * reference. This is repeated for every kernel family the cpu supports.
+ *
+ * @return void
+ */
+int8_t test_memmove_unaligned();
+
+/**
+ * @brief function to test memset and memzero at every misalignment
+ * 
+ * This function calls my_memset, my_memzero and my_memzero_stream for
+ * every destination offset within a vector and a range of lengths with
+ * every kernel family the cpu supports, and checks that exactly the
+ * requested bytes change. The stream threshold is lowered so that the
+ * longer lengths take the non-temporal path.
+ *
+ * @return void
+ */
+int8_t test_memset_unaligned();
+
+/**
+ * @brief function to test the reverse functionality at every misalignment
+ * 
+ * This function calls my_reverse for every offset within a vector and a
+ * range of odd and even lengths with every kernel family the cpu supports,
+ * and checks the result against the expected mirror image.
+ *
+ * @return void
+ */
+int8_t test_reverse_unaligned();
+
+/**
+ * @brief function to test the threaded memcopy and memset functionality
+ * 
+ * This function forces the threaded path of my_memcopy_mt, my_memset_mt
+ * and my_memzero_mt on a buffer spanning several pages with misaligned
+ * pointers, and checks that every chunk landed and nothing outside the
+ * requested range changed.
+ *
+ * @return void
+ */
+int8_t test_memcopy_mt();
+
+/**
+ * @brief function to test the element reverse and byte swap functionality
+ * 
+ * This function calls my_reverse16/32/64 and my_bswap16/32/64_array over a
+ * range of offsets and element counts with every kernel family the cpu
+ * supports, and checks element order, byte order and the bytes around.
+ *
+ * @return void
+ */
+int8_t test_reverse_elements();
+
+/**
+ * @brief function to test the pattern fill functionality
+ * 
+ * This function calls my_memfill_pattern with pattern lengths of 1 to
+ * MEM_PATTERN_MAX bytes and my_memset16/32/64 over a range of offsets and
+ * lengths with every kernel family the cpu supports.
+ *
+ * @return void
+ */
+int8_t test_memfill_pattern();
+
+/**
+ * @brief function to test the compare and search functionality
+ * 
+ * This function calls my_memcmp, my_memdiff, my_memchr and my_memrchr
+ * with a single difference or match at every position of a range of
+ * offsets and lengths, with every kernel family the cpu supports.
+ *
+ * @return void
+ */
+int8_t test_memcmp();
+
+/**
+ * @brief function to test the memswap functionality
+ * 
+ * This function calls my_memswap for every pair of offsets and a range of
+ * lengths with every kernel family the cpu supports, and checks both
+ * regions and the bytes around them.
+ *
+ * @return void
+ */
+int8_t test_memswap();
+
+/**
+ * @brief function to test the rotate functionality
+ * 
+ * This function calls my_rotate for every shift of every length up to the
+ * test buffer size, so both the block swap and the short side paths are
+ * exercised, and checks the rotated order.
+ *
+ * @return void
+ */
+int8_t test_rotate();
+
+/**
+ * @brief function to test the translate copy functionality
+ * 
+ * This function calls my_memxlat both into a second buffer and in place
+ * over a range of offsets and lengths with every kernel family the cpu
+ * supports, and checks every byte against a direct table lookup.
+ *
+ * @return void
+ */
+int8_t test_memxlat();
+
+/**
+ * @brief function to test the interleave and deinterleave functionality
+ * 
+ * This function splits interleaved 8-bit and 16-bit frames of 1 to
+ * MEM_CHANNELS_MAX channels with my_deinterleave8/16, joins them again
+ * with my_interleave8/16, and checks both against the original with every
+ * kernel family the cpu supports.
+ *
+ * @return void
+ */
+int8_t test_interleave();
+
+/**
+ * @brief function to test the gather and scatter copy functionality
+ * 
+ * This function gathers MEM_SEGMENT_COUNT fragments of mixed sizes into
+ * one packet with my_memcopyv, scatters it back out with my_memscatterv,
+ * and checks the packet, every fragment and the gaps between them.
+ *
+ * @return void
+ */
+int8_t test_memcopyv();
+
+/**
+ * @brief function to test the fused copy and checksum functionality
+ * 
+ * This function checks crc32_update and my_adler32 against published check
+ * values, then checks that my_memcopy_crc32 and my_memcopy_adler32 copy
+ * correctly and return the same checksum as a separate pass, including
+ * when the checksum is continued over a split buffer.
+ *
+ * @return void
+ */
+int8_t test_memcopy_checksum();
+
+/**
+ * @brief function to test the crc functionality
+ * 
+ * This function checks crc32_update and crc32c_update against published
+ * check values, then checks that the crc32 instruction and the tables give
+ * the same CRC-32C at every source alignment, and that both CRCs continue
+ * correctly over a split buffer.
+ *
+ * @return void
+ */
+int8_t test_crc();
+
+/**
+ * @brief function to test the hash functionality
+ * 
+ * This function checks hash64 against published XXH64 values, then checks
+ * that feeding the same data to hash64_update in uneven pieces gives the
+ * one-shot hash at every length and alignment, and that the seed and each
+ * byte change the result.
+ *
+ * @return void
+ */
+int8_t test_hash();
+
+/**
+ * @brief function to test the asynchronous copy functionality
+ * 
+ * This function fills the DMA queue with copies of different alignments
+ * and lengths, some longer than one controller cycle, and checks that each
+ * completes in order with its callback, that a callback can queue another
+ * copy, and that the data arrives. On HOST it also holds the simulated
+ * engine in a callback to check that a full queue refuses new copies and
+ * that a zero length copy waits in the queue for its callback.
+ *
+ * @return void
+ */
+int8_t test_memcopy_async();
+
+/**
+ * @brief function to test the aligned allocation functionality
+ * 
+ * This function reserves blocks at every power of two alignment up to
+ * MEM_ALIGN_MAX with reserve_words_aligned and reserve_bytes_aligned,
+ * checks their alignment and that the whole block can be written while
+ * other blocks are live, and checks that alignments that are not powers
+ * of two are refused.
+ *
+ * @return void
+ */
+int8_t test_reserve_aligned();
+
+/**
+ * @brief function to test the pool allocator functionality
+ * 
+ * This function takes every block of the smallest pool class, checks that
+ * the blocks are distinct, aligned and owned by the pool, that a further
+ * request spills into the next class and that requests larger than every
+ * class are refused, then returns the blocks and checks they are reused.
+ * MSP432 builds without ALLOCATOR=pool have no pool and pass.
+ *
+ * @return void
+ */
+int8_t test_pool();
+
+/**
+ * @brief function to test the arena allocator functionality
+ * 
+ * This function allocates from an arena over an odd sized, misaligned
+ * region and checks alignment and that allocations do not overlap or leave
+ * the region, that running out returns NULL, and that resetting to a mark
+ * hands the same memory out again.
+ *
+ * @return void
+ */
+int8_t test_arena();
+
+/**
+ * @brief function to test the slab allocator functionality
+ * 
+ * On HOST this function checks the size classes and their alignment, that
+ * many live objects do not overlap and freed ones are reused, that large
+ * requests are mapped directly, and that threads allocating, freeing and
+ * freeing each other's objects at once keep every object intact. Other
+ * platforms have no slab allocator and pass.
+ *
+ * @return void
+ */
+int8_t test_slab();
+
+/**
+ * @brief function to test the TLSF allocator functionality
+ * 
+ * This function checks that requests larger than the heap are refused, and
+ * runs a random mix of allocations and frees that checks alignment, that
+ * live blocks keep their contents, and that the heap stays consistent.
+ * Once everything is freed the free blocks must have merged back to what
+ * they were before, and half the heap must be available in one block.
+ * MSP432 builds without ALLOCATOR=tlsf have no TLSF heap and pass.
+ *
+ * @return void
+ */
+int8_t test_tlsf();
+
+/**
+ * @brief function to test the huge page path of reserve_words
+ * 
+ * This function checks that my_mem_alloc_stats counts each reserve_words
+ * call once, on the heap for a small block. On HOST it lowers the huge
+ * page threshold and checks that a larger block can be written end to end
+ * and, when it was mapped, is aligned to MEM_HUGE_PAGE_SIZE, and that
+ * freeing mappings makes room for more than MEM_HUGE_MAPPINGS of them.
+ *
+ * @return void
+ */
+int8_t test_reserve_huge();
+
 #endif /* __COURSE1_H__ */
 
@@ -0,0 +1,113 @@
+/******************************************************************************
+ * Copyright (C) 2025 by Albert Olszewski
+ *
+ * Redistribution, modification or use of this software in source or binary
+ * forms is permitted as long as the files maintain this copyright. Users are
+ * permitted to modify this and use it to learn about the field of embedded
+ * software. Alex Fosdick and the University of Colorado are not liable for any
+ * misuse of this material.
+ *
+ *****************************************************************************/
+/**
+ * @file crc.h
+ * @brief Cyclic redundancy checks over data buffers
+ *
+ * This header file provides CRC-32 (IEEE 802.3) and CRC-32C (Castagnoli)
+ * over byte buffers. Both are computed with slicing-by-8 tables, and on
+ * x86 HOST builds CRC-32C uses the SSE4.2 crc32 instruction when the cpu
+ * has it. Every function takes the CRC of the data before it, so frames
+ * can be checked incrementally as they arrive.
+ *
+ * @author Albert Olszewski
+ * @date October 17, 2026
+ *
+ */
+#ifndef __CRC_H__
+#define __CRC_H__
+
+#include <stdint.h>
+#include <stdlib.h>
+
+/* Table slices, 8 KiB of tables per polynomial. MSP432 always uses 4,
+ * the tables it keeps in flash are built for that many. */
+#if defined (MSP432)
+#undef CRC_SLICES
+#define CRC_SLICES (4)
+#elif !defined (CRC_SLICES)
+#define CRC_SLICES (8)
+#endif
+
+/**
+ * @brief Ways the CRC-32C can be computed
+ */
+typedef enum {
+  CRC_IMPL_TABLE = 0,
+  CRC_IMPL_HW
+} crc_impl_t;
+
+/**
+ * @brief Updates a CRC-32 with more data
+ *
+ * Standard reflected CRC-32 (IEEE 802.3, as used by zlib and Ethernet).
+ * Pass 0 to start and the previous result to continue over the next part
+ * of a stream.
+ *
+ * @param src Pointer to the data
+ * @param length Number of bytes of data
+ * @param crc CRC of the preceding data, 0 for none
+ *
+ * @return The updated CRC.
+ */
+uint32_t crc32_update(uint8_t * src, size_t length, uint32_t crc);
+
+/**
+ * @brief Copies data and updates a CRC-32 with it in the same pass
+ *
+ * Same result as copying the data and calling crc32_update on it, but the
+ * data is read once. The regions must not overlap.
+ *
+ * @param src Pointer to source data array
+ * @param dst Pointer to destination data array
+ * @param length Number of bytes to copy
+ * @param crc CRC of the preceding data, 0 for none
+ *
+ * @return The updated CRC.
+ */
+uint32_t crc32_copy(uint8_t * src, uint8_t * dst, size_t length, uint32_t crc);
+
+/**
+ * @brief Updates a CRC-32C with more data
+ *
+ * Reflected CRC-32C (Castagnoli, as used by iSCSI and ext4). Uses the
+ * crc32 instruction when it was selected, see crc_select.
+ *
+ * @param src Pointer to the data
+ * @param length Number of bytes of data
+ * @param crc CRC of the preceding data, 0 for none
+ *
+ * @return The updated CRC.
+ */
+uint32_t crc32c_update(uint8_t * src, size_t length, uint32_t crc);
+
+/**
+ * @brief Selects how CRC-32C is computed
+ *
+ * On x86 HOST builds the crc32 instruction is chosen at startup when the
+ * cpu supports SSE4.2. This function overrides that choice, for example to
+ * compare the two. A request the cpu cannot run falls back to the tables.
+ * Both produce identical results.
+ *
+ * @param impl The implementation to use
+ *
+ * @return The implementation actually selected.
+ */
+crc_impl_t crc_select(crc_impl_t impl);
+
+/**
+ * @brief Returns how CRC-32C is computed
+ *
+ * @return The implementation currently selected.
+ */
+crc_impl_t crc_impl(void);
+
+#endif /* __CRC_H__ */
@@ -0,0 +1,97 @@
+/******************************************************************************
+ * Copyright (C) 2025 by Albert Olszewski
+ *
+ * Redistribution, modification or use of this software in source or binary
+ * forms is permitted as long as the files maintain this copyright. Users are
+ * permitted to modify this and use it to learn about the field of embedded
+ * software. Alex Fosdick and the University of Colorado are not liable for any
+ * misuse of this material.
+ *
+ *****************************************************************************/
+/**
+ * @file dma.h
+ * @brief Asynchronous copies with the DMA controller
+ *
+ * This header file provides copies that run in the background while the
+ * core does other work. On MSP432 they are done by the uDMA controller
+ * and completion is signalled from its interrupt. HOST builds have a
+ * simulated engine on its own thread that follows the same rules, so the
+ * queueing and completion logic can be tested off target.
+ *
+ * Copies are queued and run one after another in the order given. Each
+ * is split into cycles of at most DMA_MAX_TRANSFERS transfers, as the
+ * controller requires.
+ *
+ * @author Albert Olszewski
+ * @date October 17, 2026
+ *
+ */
+#ifndef __DMA_H__
+#define __DMA_H__
+
+#include <stdint.h>
+#include <stdlib.h>
+
+#define DMA_QUEUE_DEPTH   (8)
+#define DMA_MAX_TRANSFERS (1024)
+#define DMA_CHANNEL       (0)
+
+/**
+ * @brief Function called when an asynchronous copy finishes
+ *
+ * On MSP432 it runs in the DMA interrupt, on HOST on the engine thread,
+ * so it should be short. It may queue another copy.
+ *
+ * @param dst Destination the copy was made to
+ * @param length Number of bytes copied, less than requested after a bus error
+ *
+ * @return void
+ */
+typedef void (*dma_callback_t)(uint8_t * dst, size_t length);
+
+/**
+ * @brief Starts copying data in the background
+ *
+ * Queues a copy of length bytes from src to dst and returns at once. The
+ * regions must not overlap and must not be touched until the callback
+ * has run. Aligned regions are moved a word per transfer, others a half
+ * word or byte at a time. A zero length copy is queued like any other and
+ * its callback runs in the same place.
+ *
+ * @param src Pointer to source data array
+ * @param dst Pointer to destination data array
+ * @param length Number of bytes to copy
+ * @param callback Function called when the copy is done, or NULL
+ *
+ * @return Pointer to dst, or NULL if the queue is full.
+ */
+uint8_t * my_memcopy_async(uint8_t * src, uint8_t * dst, size_t length, dma_callback_t callback);
+
+/**
+ * @brief Returns the number of copies not yet finished
+ *
+ * A copy counts until its callback has returned.
+ *
+ * @return Copies queued or running.
+ */
+uint32_t dma_pending(void);
+
+/**
+ * @brief Waits for every queued copy to finish
+ *
+ * Must not be called from a callback.
+ *
+ * @return void
+ */
+void dma_wait(void);
+
+/**
+ * @brief Returns the number of copies cut short by a bus error
+ *
+ * Always 0 on HOST.
+ *
+ * @return Errors since startup.
+ */
+uint32_t dma_errors(void);
+
+#endif /* __DMA_H__ */
@@ -0,0 +1,89 @@
+/******************************************************************************
+ * Copyright (C) 2025 by Albert Olszewski
+ *
+ * Redistribution, modification or use of this software in source or binary
+ * forms is permitted as long as the files maintain this copyright. Users are
+ * permitted to modify this and use it to learn about the field of embedded
+ * software. Alex Fosdick and the University of Colorado are not liable for any
+ * misuse of this material.
+ *
+ *****************************************************************************/
+/**
+ * @file hash.h
+ * @brief Non-cryptographic 64-bit hash of data buffers
+ *
+ * This header file provides a 64-bit hash for keying caches and finding
+ * repeated buffers. It is XXH64: input is consumed in 32-byte stripes by
+ * four independent lanes, and the result is the same on every platform.
+ * It must not be used where an attacker chooses the input.
+ *
+ * @author Albert Olszewski
+ * @date October 17, 2026
+ *
+ */
+#ifndef __HASH_H__
+#define __HASH_H__
+
+#include <stdint.h>
+#include <stdlib.h>
+
+#define HASH_STRIPE (32)
+
+/**
+ * @brief State of a hash computed over several calls
+ */
+typedef struct {
+  uint64_t lanes[4];
+  uint64_t total;
+  uint64_t seed;
+  uint8_t buffer[HASH_STRIPE];
+  uint32_t buffered;
+} hash_state_t;
+
+/**
+ * @brief Hashes a buffer in one call
+ *
+ * @param src Pointer to the data
+ * @param length Number of bytes of data
+ * @param seed Value that selects a different hash function, 0 by default
+ *
+ * @return The 64-bit hash.
+ */
+uint64_t hash64(uint8_t * src, size_t length, uint64_t seed);
+
+/**
+ * @brief Starts a hash computed over several calls
+ *
+ * @param state Pointer to the state to initialize
+ * @param seed Value that selects a different hash function, 0 by default
+ *
+ * @return void
+ */
+void hash64_init(hash_state_t * state, uint64_t seed);
+
+/**
+ * @brief Adds data to a hash
+ *
+ * The data may be split anywhere; the result only depends on the bytes
+ * in order.
+ *
+ * @param state Pointer to a state set up by hash64_init
+ * @param src Pointer to the data
+ * @param length Number of bytes of data
+ *
+ * @return void
+ */
+void hash64_update(hash_state_t * state, uint8_t * src, size_t length);
+
+/**
+ * @brief Returns the hash of all data added so far
+ *
+ * The state is not changed, so more data can still be added.
+ *
+ * @param state Pointer to the state
+ *
+ * @return The same hash hash64 gives for the concatenated data.
+ */
+uint64_t hash64_final(const hash_state_t * state);
+
+#endif /* __HASH_H__ */
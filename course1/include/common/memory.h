@@ -25,6 +25,65 @@
 #include <stdint.h>
 #include <stdlib.h>
 
+/**
+ * @brief Kernel families used by the bulk memory operations
+ *
+ * Ordered from narrowest to widest. The vector families only exist on
+ * x86 HOST builds; every other build always runs the scalar kernels.
+ */
+typedef enum {
+  MEM_IMPL_SCALAR = 0,
+  MEM_IMPL_SSE2,
+  MEM_IMPL_AVX2
+} mem_impl_t;
+
+/**
+ * @brief One fragment of a gather or scatter copy
+ *
+ * Describes length bytes starting at ptr, see my_memcopyv.
+ */
+typedef struct {
+  uint8_t * ptr;
+  size_t length;
+} mem_segment_t;
+
+/* Largest size in bytes handled without a loop by move, copy and set */
+#define MEM_SMALL_SIZE (64)
+
+/* Default size in bytes at which my_memset and my_memzero stream */
+#define MEM_STREAM_THRESHOLD (32u * 1024u * 1024u)
+
+/* Largest block in bytes my_memfill_pattern repeats once it is seeded */
+#define MEM_FILL_BLOCK (4096)
+
+/* Default worker count and cutoff in bytes for the parallel variants */
+#define MEM_MT_THREADS       (4)
+#define MEM_MT_THREADS_MAX   (64)
+#define MEM_MT_THRESHOLD     (8u * 1024u * 1024u)
+
+/* Default size in bytes above which reserve_words maps huge pages (HOST),
+ * the huge page size, and how many such mappings may be live at once;
+ * past that, large blocks come from the heap again */
+#define MEM_HUGE_THRESHOLD   (32u * 1024u * 1024u)
+#define MEM_HUGE_PAGE_SIZE   (2u * 1024u * 1024u)
+#define MEM_HUGE_MAPPINGS    (64)
+
+/**
+ * @brief Number of reserve_words calls served by each path
+ *
+ * See reserve_words and my_mem_alloc_stats.
+ */
+typedef struct {
+  uint64_t heap;     // malloc, or the backend chosen with ALLOCATOR
+  uint64_t hugetlb;  // mmap with MAP_HUGETLB, from the reserved huge pages
+  uint64_t thp;      // mmap with madvise(MADV_HUGEPAGE), transparent huge pages
+} mem_alloc_stats_t;
+
+/* Common alignments for reserve_words_aligned: a cache line, and the
+ * widest vector load (AVX2) */
+#define MEM_ALIGN_CACHE_LINE (64)
+#define MEM_ALIGN_SIMD       (32)
+
 /**
  * @brief Sets a value of a data array 
  *
@@ -98,7 +157,11 @@ void clear_all(char * ptr, unsigned int size);
  *
  * Given a pointer to a source and destination data set, this will move
  * a number of elements from the source to the destination. The length is
- * determined by the provided size parameter.
+ * determined by the provided size parameter. Overlapping regions are
+ * handled by copying backwards when the destination starts inside the
+ * source. The bulk of the move is done a native word at a time (32-bit
+ * on MSP432, 64-bit on HOST) once the destination is word aligned. On
+ * MSP432, when the source is aligned too, 8-word LDM/STM bursts are used.
  *
  * @param src Pointer to source data array
  * @param dst Pointer to destination data array
@@ -114,7 +177,8 @@ uint8_t * my_memmove(uint8_t * src, uint8_t * dst, size_t length);
  * Given a pointer to a source and destination data set, this will copy
  * a number of elements from the source to the destination. The length is
  * determined by the provided size parameter. This function does not
- * handle overlapping memory regions.
+ * handle overlapping memory regions. Like my_memmove, the bulk of the
+ * copy is done a native word at a time once the destination is aligned.
  * 
  * @param src Pointer to source data array
  * @param dst Pointer to destination data array
@@ -124,12 +188,109 @@ uint8_t * my_memmove(uint8_t * src, uint8_t * dst, size_t length);
  */
 uint8_t * my_memcopy(uint8_t * src, uint8_t * dst, size_t length);
 
+/**
+ * @brief Gathers several memory fragments into one contiguous region
+ * 
+ * Given a destination and an array of segments, this function copies the
+ * segments one after another into the destination, for example a header,
+ * a text field and a payload into one packet. The whole batch shares one
+ * setup: small segments take the loop-free small size path and larger
+ * ones the bulk copy kernel. The segments must not overlap the
+ * destination.
+ * 
+ * @param dst Pointer to the destination data array
+ * @param segs Array of count segments to copy from
+ * @param count Number of segments
+ * 
+ * @return Total number of bytes copied.
+ */
+size_t my_memcopyv(uint8_t * dst, const mem_segment_t * segs, size_t count);
+
+/**
+ * @brief Scatters one contiguous region into several memory fragments
+ * 
+ * The inverse of my_memcopyv: consecutive bytes from src are copied into
+ * each segment in turn.
+ * 
+ * @param src Pointer to the source data array
+ * @param segs Array of count segments to copy into
+ * @param count Number of segments
+ * 
+ * @return Total number of bytes copied.
+ */
+size_t my_memscatterv(uint8_t * src, const mem_segment_t * segs, size_t count);
+
+/**
+ * @brief Computes the CRC-32 of a memory region
+ * 
+ * Standard reflected CRC-32 (IEEE 802.3, as used by zlib and Ethernet).
+ * Same as crc32_update (see crc.h), kept here next to the other checksum
+ * functions. Pass 0 to start and the previous result to continue over the
+ * next part of a stream.
+ * 
+ * @param src Pointer to the memory region
+ * @param length Number of bytes to checksum
+ * @param crc CRC of the preceding data, 0 for none
+ * 
+ * @return The updated CRC.
+ */
+uint32_t my_crc32(uint8_t * src, size_t length, uint32_t crc);
+
+/**
+ * @brief Copies data and computes its CRC-32 in the same pass
+ * 
+ * Same result as my_memcopy followed by my_crc32, but each word is folded
+ * into the CRC while it is in a register on its way to the destination,
+ * so the data is read once. The regions must not overlap.
+ * 
+ * @param src Pointer to source data array
+ * @param dst Pointer to destination data array
+ * @param length Number of bytes to copy
+ * @param crc CRC of the preceding data, 0 for none
+ * 
+ * @return The updated CRC.
+ */
+uint32_t my_memcopy_crc32(uint8_t * src, uint8_t * dst, size_t length, uint32_t crc);
+
+/**
+ * @brief Computes the Adler-32 checksum of a memory region
+ * 
+ * Standard Adler-32 (RFC 1950). Pass 1 to start and the previous result
+ * to continue over the next part of a stream.
+ * 
+ * @param src Pointer to the memory region
+ * @param length Number of bytes to checksum
+ * @param adler Checksum of the preceding data, 1 for none
+ * 
+ * @return The updated checksum.
+ */
+uint32_t my_adler32(uint8_t * src, size_t length, uint32_t adler);
+
+/**
+ * @brief Copies data and computes its Adler-32 checksum in the same pass
+ * 
+ * Same result as my_memcopy followed by my_adler32, with the data read
+ * once. The regions must not overlap.
+ * 
+ * @param src Pointer to source data array
+ * @param dst Pointer to destination data array
+ * @param length Number of bytes to copy
+ * @param adler Checksum of the preceding data, 1 for none
+ * 
+ * @return The updated checksum.
+ */
+uint32_t my_memcopy_adler32(uint8_t * src, uint8_t * dst, size_t length, uint32_t adler);
+
 /**
  * @brief Sets all locations in a memory region to a specific value
  * 
  * Given a pointer to a memory region, this function sets all bytes
  * in that region to a specific value. 
  * 
+ * Regions of at least the stream threshold (see
+ * my_mem_set_stream_threshold) are written with non-temporal stores so
+ * they do not evict the rest of the working set from the cache.
+ * 
  * @param src Pointer to the memory region
  * @param length Number of bytes to set
  * @param value The value to set each byte to
@@ -151,11 +312,251 @@ uint8_t * my_memset(uint8_t * src, size_t length, uint8_t value);
  */
 uint8_t * my_memzero(uint8_t * src, size_t length);
 
+/**
+ * @brief Sets all locations in a memory region to zero, bypassing the cache
+ * 
+ * Like my_memzero, but always uses non-temporal stores followed by a store
+ * fence, whatever the length. Use it for regions that will not be read
+ * back soon. Builds without streaming stores fall back to my_memzero.
+ * 
+ * @param src Pointer to the memory region
+ * @param length Number of bytes to set to zero
+ * 
+ * @return src Pointer to the source memory region.
+ */
+uint8_t * my_memzero_stream(uint8_t * src, size_t length);
+
+/**
+ * @brief Sets every 16-bit element of an array to a value
+ * 
+ * Given a pointer to an array of 16-bit elements and its length in
+ * elements, this function sets every element to the value. The value is
+ * broadcast into a full vector or word and stored at full width.
+ * my_memset32 and my_memset64 do the same for 32-bit and 64-bit elements.
+ * 
+ * @param src Pointer to the array
+ * @param length Number of elements to set
+ * @param value The value to set each element to
+ * 
+ * @return src Pointer to the array.
+ */
+uint16_t * my_memset16(uint16_t * src, size_t length, uint16_t value);
+uint32_t * my_memset32(uint32_t * src, size_t length, uint32_t value);
+uint64_t * my_memset64(uint64_t * src, size_t length, uint64_t value);
+
+/**
+ * @brief Fills a memory region with a repeating byte pattern
+ * 
+ * Given a pointer to a memory region and its length in bytes, this
+ * function repeats the pattern from the start of the region, cutting the
+ * last copy short if needed. Patterns of 1, 2, 4 or 8 bytes are broadcast
+ * and stored at full width; other lengths are seeded once and then
+ * doubled with my_memcopy. The pattern must not overlap the region.
+ * 
+ * @param src Pointer to the memory region
+ * @param length Number of bytes to fill
+ * @param pattern Pointer to the pattern bytes
+ * @param pattern_length Number of bytes in the pattern
+ * 
+ * @return src Pointer to the source memory region.
+ */
+uint8_t * my_memfill_pattern(uint8_t * src, size_t length, uint8_t * pattern, size_t pattern_length);
+
+/**
+ * @brief Exchanges the contents of two memory regions
+ * 
+ * Given pointers to two equal length memory regions, this function swaps
+ * their contents in a single pass, a vector or word from each side at a
+ * time, without a scratch buffer. The regions must not overlap.
+ * 
+ * @param src Pointer to the first memory region
+ * @param dst Pointer to the second memory region
+ * @param length Number of bytes to swap
+ * 
+ * @return src Pointer to the first memory region.
+ */
+uint8_t * my_memswap(uint8_t * src, uint8_t * dst, size_t length);
+
+/**
+ * @brief Rotates a memory region in place
+ * 
+ * Given a pointer to a memory region and its length, this function
+ * rotates the region left by shift bytes, so the byte at offset shift
+ * comes first and the bytes before it move to the end. For example this
+ * puts the oldest sample of a ring buffer first. The rotation uses the
+ * block swap scheme: equal blocks from the two sides are exchanged with
+ * my_memswap until one side is small enough to park on the stack for a
+ * final my_memmove. Extra memory is bounded by MEM_SMALL_SIZE bytes.
+ * 
+ * @param src Pointer to the memory region
+ * @param length Number of bytes in the region
+ * @param shift Number of bytes to rotate left by, taken modulo length
+ * 
+ * @return src Pointer to the memory region.
+ */
+uint8_t * my_rotate(uint8_t * src, size_t length, size_t shift);
+
+/**
+ * @brief Copies data while translating each byte through a table
+ * 
+ * Given a pointer to a source and destination data set and a 256 entry
+ * lookup table, this function writes table[src[i]] to dst[i] for length
+ * bytes in a single pass. AVX2 builds look up 32 bytes per step with
+ * nibble shuffles; other builds use an unrolled table walk. The
+ * translation may be done in place with src equal to dst; otherwise the
+ * regions must not overlap.
+ * 
+ * @param src Pointer to source data array
+ * @param dst Pointer to destination data array
+ * @param length Number of bytes to translate
+ * @param table Pointer to the 256 byte lookup table
+ * 
+ * @return dst Pointer to the destination.
+ */
+uint8_t * my_memxlat(uint8_t * src, uint8_t * dst, size_t length, uint8_t * table);
+
+/**
+ * @brief Splits interleaved 8-bit samples into one array per channel
+ * 
+ * Given a source of frames interleaved as ch0, ch1, ..., chN-1, ch0, ...
+ * this function writes the samples of channel c to dsts[c]. On x86 HOST,
+ * 2 to 4 channels are split 32 frames at a time with 256-bit byte
+ * shuffles (AVX2) or, for 2 channels, 16 frames at a time with shifts and
+ * packs (SSE2); other channel counts and builds use a scalar loop.
+ * my_deinterleave16 does the same for 16-bit samples, half as many frames
+ * at a time.
+ * 
+ * @param src Pointer to the interleaved samples
+ * @param dsts Array of channels pointers, one destination per channel
+ * @param channels Number of channels per frame
+ * @param frames Number of frames to split
+ * 
+ * @return void.
+ */
+void my_deinterleave8(uint8_t * src, uint8_t ** dsts, size_t channels, size_t frames);
+void my_deinterleave16(uint16_t * src, uint16_t ** dsts, size_t channels, size_t frames);
+
+/**
+ * @brief Joins one 8-bit sample array per channel into interleaved frames
+ * 
+ * The inverse of my_deinterleave8: frame f of dst is srcs[0][f],
+ * srcs[1][f], ..., srcs[channels - 1][f]. my_interleave16 does the same
+ * for 16-bit samples.
+ * 
+ * @param srcs Array of channels pointers, one source per channel
+ * @param dst Pointer to the interleaved destination
+ * @param channels Number of channels per frame
+ * @param frames Number of frames to join
+ * 
+ * @return void.
+ */
+void my_interleave8(uint8_t ** srcs, uint8_t * dst, size_t channels, size_t frames);
+void my_interleave16(uint16_t ** srcs, uint16_t * dst, size_t channels, size_t frames);
+
+/**
+ * @brief Compares two memory regions
+ * 
+ * Given pointers to two memory regions, this function compares length
+ * bytes of them as unsigned values. 16 or 32 bytes are compared per step
+ * with vector compares on HOST and a word per step elsewhere.
+ * 
+ * @param src Pointer to the first memory region
+ * @param dst Pointer to the second memory region
+ * @param length Number of bytes to compare
+ * 
+ * @return 0 if the regions match, otherwise the difference between the
+ *         first pair of bytes that differ (src minus dst).
+ */
+int32_t my_memcmp(uint8_t * src, uint8_t * dst, size_t length);
+
+/**
+ * @brief Finds the first byte at which two memory regions differ
+ * 
+ * @param src Pointer to the first memory region
+ * @param dst Pointer to the second memory region
+ * @param length Number of bytes to compare
+ * 
+ * @return Offset of the first differing byte, or length if they match.
+ */
+size_t my_memdiff(uint8_t * src, uint8_t * dst, size_t length);
+
+/**
+ * @brief Finds the first occurrence of a byte in a memory region
+ * 
+ * Given a pointer to a memory region, this function searches length bytes
+ * for the value. Vector compares and movemask are used on HOST and a
+ * SWAR zero byte test a word at a time elsewhere.
+ * 
+ * @param src Pointer to the memory region
+ * @param length Number of bytes to search
+ * @param value The value to search for
+ * 
+ * @return Pointer to the first matching byte, or NULL if there is none.
+ */
+uint8_t * my_memchr(uint8_t * src, size_t length, uint8_t value);
+
+/**
+ * @brief Finds the last occurrence of a byte in a memory region
+ * 
+ * Like my_memchr, but searches from the end of the region.
+ * 
+ * @param src Pointer to the memory region
+ * @param length Number of bytes to search
+ * @param value The value to search for
+ * 
+ * @return Pointer to the last matching byte, or NULL if there is none.
+ */
+uint8_t * my_memrchr(uint8_t * src, size_t length, uint8_t value);
+
+/**
+ * @brief Copies data from one memory location to another using threads
+ * 
+ * Same contract as my_memcopy. On HOST, copies of at least the parallel
+ * cutoff are split into chunks that end on page boundaries of the
+ * destination and copied by the configured number of threads, the caller
+ * included. The function returns once every chunk has been copied.
+ * Smaller copies, and every copy on MSP432, run on the calling thread.
+ * 
+ * @param src Pointer to source data array
+ * @param dst Pointer to destination data array
+ * @param length Number of bytes to copy
+ * 
+ * @return dst Pointer to the destination.
+ */
+uint8_t * my_memcopy_mt(uint8_t * src, uint8_t * dst, size_t length);
+
+/**
+ * @brief Sets all locations in a memory region to a value using threads
+ * 
+ * Same contract as my_memset, split across threads like my_memcopy_mt.
+ * 
+ * @param src Pointer to the memory region
+ * @param length Number of bytes to set
+ * @param value The value to set each byte to
+ * 
+ * @return src Pointer to the source memory region.
+ */
+uint8_t * my_memset_mt(uint8_t * src, size_t length, uint8_t value);
+
+/**
+ * @brief Sets all locations in a memory region to zero using threads
+ * 
+ * Same contract as my_memzero, split across threads like my_memcopy_mt.
+ * 
+ * @param src Pointer to the memory region
+ * @param length Number of bytes to set to zero
+ * 
+ * @return src Pointer to the source memory region.
+ */
+uint8_t * my_memzero_mt(uint8_t * src, size_t length);
+
 /**
  * @brief Reverses the order of bytes in a memory region
  * 
  * Given a pointer to a memory region and its length, this function
- * reverses the order of bytes in that region.
+ * reverses the order of bytes in that region. Blocks are taken from both
+ * ends at once and byte reversed on the way (32 bytes with AVX2, 16 with
+ * SSE2 or __REV on MSP432), so any length and alignment is supported.
  * 
  * @param src Pointer to the memory region
  * @param length Number of bytes to reverse
@@ -164,6 +565,122 @@ uint8_t * my_memzero(uint8_t * src, size_t length);
  */
 uint8_t * my_reverse(uint8_t * src, size_t length);
 
+/**
+ * @brief Reverses the order of 16-bit elements in a memory region
+ * 
+ * Given a pointer to an array of 16-bit elements and its length in
+ * elements, this function reverses the order of the elements. The bytes
+ * within each element keep their order. my_reverse32 and my_reverse64 do
+ * the same for 32-bit and 64-bit elements.
+ * 
+ * @param src Pointer to the array
+ * @param length Number of elements to reverse
+ * 
+ * @return src Pointer to the array.
+ */
+uint16_t * my_reverse16(uint16_t * src, size_t length);
+uint32_t * my_reverse32(uint32_t * src, size_t length);
+uint64_t * my_reverse64(uint64_t * src, size_t length);
+
+/**
+ * @brief Byte swaps every 16-bit element of an array in place
+ * 
+ * Given a pointer to an array of 16-bit elements and its length in
+ * elements, this function reverses the bytes of each element, for example
+ * to convert between host and wire byte order. my_bswap32_array and
+ * my_bswap64_array do the same for 32-bit and 64-bit elements. Vector
+ * shuffles are used on HOST and __REV/__REV16 on MSP432.
+ * 
+ * @param src Pointer to the array
+ * @param length Number of elements to byte swap
+ * 
+ * @return src Pointer to the array.
+ */
+uint16_t * my_bswap16_array(uint16_t * src, size_t length);
+uint32_t * my_bswap32_array(uint32_t * src, size_t length);
+uint64_t * my_bswap64_array(uint64_t * src, size_t length);
+
+/**
+ * @brief Selects the kernels used by the bulk memory operations
+ * 
+ * On x86 HOST builds the widest kernels the cpu supports are chosen once
+ * at startup from cpuid. This function overrides that choice, for example
+ * to compare the variants. A request for a family the cpu cannot run is
+ * lowered to the widest supported one. All families produce identical
+ * results.
+ * 
+ * @param impl The kernel family to use
+ * 
+ * @return The kernel family actually selected.
+ */
+mem_impl_t my_mem_select(mem_impl_t impl);
+
+/**
+ * @brief Returns the kernels used by the bulk memory operations
+ * 
+ * @return The kernel family currently selected.
+ */
+mem_impl_t my_mem_impl(void);
+
+/**
+ * @brief Sets the size at which my_memset and my_memzero start streaming
+ * 
+ * Regions of at least this many bytes are written with non-temporal
+ * stores. The default is MEM_STREAM_THRESHOLD; a threshold of zero turns
+ * streaming off for my_memset and my_memzero.
+ * 
+ * @param threshold Size in bytes at which streaming starts
+ * 
+ * @return The previous threshold.
+ */
+size_t my_mem_set_stream_threshold(size_t threshold);
+
+/**
+ * @brief Sets the number of threads used by the parallel variants
+ * 
+ * The count includes the calling thread and is capped at
+ * MEM_MT_THREADS_MAX. The default is MEM_MT_THREADS; zero is taken as one.
+ * 
+ * @param threads Number of threads to split a request across
+ * 
+ * @return The previous thread count.
+ */
+size_t my_mem_set_threads(size_t threads);
+
+/**
+ * @brief Sets the size at which the parallel variants use threads
+ * 
+ * Requests smaller than this many bytes run on the calling thread. The
+ * default is MEM_MT_THRESHOLD.
+ * 
+ * @param threshold Size in bytes at which threads are used
+ * 
+ * @return The previous threshold.
+ */
+size_t my_mem_set_mt_threshold(size_t threshold);
+
+/**
+ * @brief Sets the size above which reserve_words maps huge pages
+ * 
+ * Only HOST builds on Linux map huge pages; elsewhere the threshold is
+ * kept but unused. The default is MEM_HUGE_THRESHOLD.
+ * 
+ * @param threshold Size in bytes above which huge pages are used
+ * 
+ * @return The previous threshold.
+ */
+size_t my_mem_set_huge_threshold(size_t threshold);
+
+/**
+ * @brief Reports how reserve_words calls have been served
+ * 
+ * Counts every successful call since the program started.
+ * 
+ * @param stats Receives the count for each path
+ * 
+ * @return void
+ */
+void my_mem_alloc_stats(mem_alloc_stats_t * stats);
 
 /**
  * @brief Reserves a block of dynamic memory for words
@@ -172,6 +689,20 @@ uint8_t * my_reverse(uint8_t * src, size_t length);
  * 32-bit words. It allocates memory dynamically and returns a pointer to
  * memory if successful, or NULL if allocation fails.
  * 
+ * Built with -DMEM_ALLOC_POOL the block comes from the fixed-block pool
+ * (see pool.h) when one fits, and from malloc otherwise. Built with
+ * -DMEM_ALLOC_SLAB (HOST only) it comes from the slab allocator (see
+ * slab.h). Built with -DMEM_ALLOC_TLSF it comes from the TLSF heap (see
+ * tlsf.h), with no fallback.
+ * 
+ * On HOST, blocks larger than the huge page threshold (see
+ * my_mem_set_huge_threshold) are mapped on their own, from huge pages to
+ * cut TLB misses. Reserved huge pages (MAP_HUGETLB) are tried first, then
+ * a 2 MB aligned mapping marked with madvise(MADV_HUGEPAGE), then the
+ * path above. At most MEM_HUGE_MAPPINGS blocks are mapped at once; further
+ * large blocks take the path above until one is freed. my_mem_alloc_stats
+ * counts the path each call took.
+ * 
  * @param length The number of 32-bit words to reserve
  * 
  * @return ptr A pointer to the reserved memory block, or NULL if allocation fails.
@@ -189,4 +720,41 @@ int32_t * reserve_words(size_t length);
  */
 void free_words(int32_t * src);
 
+/**
+ * @brief Reserves a block of dynamic memory for words at an alignment
+ * 
+ * Same as reserve_words, but the block starts at a multiple of alignment
+ * bytes, for example MEM_ALIGN_CACHE_LINE for buffers shared between
+ * threads or MEM_ALIGN_SIMD for vector kernels and DMA. The block must be
+ * released with free_aligned.
+ * 
+ * @param length The number of 32-bit words to reserve
+ * @param alignment Required alignment in bytes, a power of two
+ * 
+ * @return A pointer to the reserved memory block, or NULL if allocation
+ * fails or alignment is not a power of two.
+ */
+int32_t * reserve_words_aligned(size_t length, size_t alignment);
+
+/**
+ * @brief Reserves a block of dynamic memory for bytes at an alignment
+ * 
+ * Byte count variant of reserve_words_aligned. The block must be released
+ * with free_aligned.
+ * 
+ * @param length The number of bytes to reserve
+ * @param alignment Required alignment in bytes, a power of two
+ * 
+ * @return A pointer to the reserved memory block, or NULL if allocation
+ * fails or alignment is not a power of two.
+ */
+uint8_t * reserve_bytes_aligned(size_t length, size_t alignment);
+
+/**
+ * @brief Frees a block from reserve_words_aligned or reserve_bytes_aligned
+ * 
+ * @param src Pointer to the memory block to free, NULL is ignored
+ */
+void free_aligned(void * src);
+
 #endif /* __MEMORY_H__ */
@@ -0,0 +1,103 @@
+/******************************************************************************
+ * Copyright (C) 2025 by Albert Olszewski
+ *
+ * Redistribution, modification or use of this software in source or binary
+ * forms is permitted as long as the files maintain this copyright. Users are
+ * permitted to modify this and use it to learn about the field of embedded
+ * software. Alex Fosdick and the University of Colorado are not liable for any
+ * misuse of this material.
+ *
+ *****************************************************************************/
+/**
+ * @file pool.h
+ * @brief Fixed-block pool allocator
+ *
+ * This header file provides a deterministic allocator made of a few
+ * classes of equal sized blocks. Each class keeps its free blocks on a
+ * list, so allocating and freeing take constant time and never fragment.
+ * On MSP432 the blocks live in the .heap section of the linker script,
+ * ahead of the region newlib's malloc grows into, and the link fails if
+ * they reach the space kept for the stack.
+ *
+ * Building with -DMEM_ALLOC_POOL (make ALLOCATOR=pool) makes the pool the
+ * backend of reserve_words and free_words. On MSP432 pool.c is only built
+ * then, so the blocks do not take SRAM from malloc in other builds.
+ *
+ * @author Albert Olszewski
+ * @date October 17, 2026
+ *
+ */
+#ifndef __POOL_H__
+#define __POOL_H__
+
+#include <stdint.h>
+#include <stdlib.h>
+
+/* Defined when pool.c is part of the build */
+#if defined (HOST) || defined (MEM_ALLOC_POOL)
+#define POOL_AVAILABLE
+#endif
+
+/* Block classes as X(block size in bytes, block count), smallest first.
+ * Sizes must be multiples of 8. Override on the command line, e.g.
+ * -D'POOL_CLASSES(X)=X(64, 16) X(1024, 4)'. */
+#if !defined (POOL_CLASSES)
+#define POOL_CLASSES(X) \
+  X(32, 32)             \
+  X(128, 16)            \
+  X(512, 8)             \
+  X(2048, 4)
+#endif
+
+/**
+ * @brief Allocates a block from the pool
+ *
+ * Takes a block from the smallest class that fits length. If that class
+ * is used up the next larger one is tried.
+ *
+ * @param length Number of bytes needed
+ *
+ * @return Pointer to an 8-byte aligned block, or NULL if no class has a
+ * free block large enough.
+ */
+void * pool_alloc(size_t length);
+
+/**
+ * @brief Returns a block to the pool
+ *
+ * @param ptr Pointer from pool_alloc, NULL is ignored
+ *
+ * @return void
+ */
+void pool_free(void * ptr);
+
+/**
+ * @brief Tells whether a pointer is a block of the pool
+ *
+ * @param ptr Any pointer
+ *
+ * @return 1 if ptr came from pool_alloc, 0 otherwise.
+ */
+uint8_t pool_owns(void * ptr);
+
+/**
+ * @brief Returns the block size that serves a request
+ *
+ * @param length Number of bytes needed
+ *
+ * @return Block size of the smallest class that fits length, or 0 if
+ * length is larger than every class.
+ */
+size_t pool_block_size(size_t length);
+
+/**
+ * @brief Returns the free blocks of the class that serves a request
+ *
+ * @param length Number of bytes needed
+ *
+ * @return Free blocks in the class pool_block_size(length) names, 0 if
+ * there is none.
+ */
+size_t pool_available(size_t length);
+
+#endif /* __POOL_H__ */
@@ -0,0 +1,83 @@
+/******************************************************************************
+ * Copyright (C) 2025 by Albert Olszewski
+ *
+ * Redistribution, modification or use of this software in source or binary
+ * forms is permitted as long as the files maintain this copyright. Users are
+ * permitted to modify this and use it to learn about the field of embedded
+ * software. Alex Fosdick and the University of Colorado are not liable for any
+ * misuse of this material.
+ *
+ *****************************************************************************/
+/**
+ * @file slab.h
+ * @brief Size-class slab allocator with per-thread caches (HOST)
+ *
+ * This header file provides an allocator for programs that allocate from
+ * many threads at once. Requests are rounded up to a power of two size
+ * class and served from slabs of that class. Every thread keeps a cache
+ * of objects per class in two magazines that only it touches, so most
+ * allocations and frees take no lock. Full and empty magazines are traded
+ * with a global depot per class, which moves memory from threads that
+ * free to threads that allocate. Requests above the largest class are
+ * mapped directly with mmap and unmapped when freed.
+ *
+ * Building with -DMEM_ALLOC_SLAB (make ALLOCATOR=slab) makes the slab
+ * allocator the backend of reserve_words and free_words. Available on
+ * HOST builds only.
+ *
+ * @author Albert Olszewski
+ * @date October 17, 2026
+ *
+ */
+#ifndef __SLAB_H__
+#define __SLAB_H__
+
+#include <stdint.h>
+#include <stdlib.h>
+
+/* Size classes are 2^SLAB_MIN_SHIFT to 2^SLAB_MAX_SHIFT bytes */
+#define SLAB_MIN_SHIFT (4)
+#define SLAB_MAX_SHIFT (15)
+#define SLAB_CLASSES   (SLAB_MAX_SHIFT - SLAB_MIN_SHIFT + 1)
+
+/* Slabs are this large and aligned to their size */
+#define SLAB_SHIFT     (18)
+#define SLAB_SIZE      ((size_t)1 << SLAB_SHIFT)
+
+/* Objects per magazine */
+#define SLAB_MAG_SIZE  (32)
+
+/**
+ * @brief Allocates memory
+ *
+ * Objects of a size class are aligned to the class size; memory mapped
+ * directly is aligned to 64 bytes.
+ *
+ * @param length Number of bytes needed
+ *
+ * @return Pointer to the memory, or NULL if the system is out of memory.
+ */
+void * slab_alloc(size_t length);
+
+/**
+ * @brief Frees memory from slab_alloc
+ *
+ * May be called from any thread, not only the one that allocated.
+ *
+ * @param ptr Pointer from slab_alloc, NULL is ignored
+ *
+ * @return void
+ */
+void slab_free(void * ptr);
+
+/**
+ * @brief Returns the size a request is rounded up to
+ *
+ * @param length Number of bytes needed
+ *
+ * @return Size of the class that serves length, or 0 if it is mapped
+ * directly.
+ */
+size_t slab_class_size(size_t length);
+
+#endif /* __SLAB_H__ */
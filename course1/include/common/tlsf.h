@@ -0,0 +1,109 @@
+/******************************************************************************
+ * Copyright (C) 2025 by Albert Olszewski
+ *
+ * Redistribution, modification or use of this software in source or binary
+ * forms is permitted as long as the files maintain this copyright. Users are
+ * permitted to modify this and use it to learn about the field of embedded
+ * software. Alex Fosdick and the University of Colorado are not liable for any
+ * misuse of this material.
+ *
+ *****************************************************************************/
+/**
+ * @file tlsf.h
+ * @brief Two-Level Segregated Fit allocator with bounded latency
+ *
+ * This header file provides a general purpose allocator whose allocate and
+ * free take a bounded number of steps regardless of the heap's history.
+ * Free blocks are kept in lists by size, indexed by a power of two (first
+ * level) and a linear subdivision of it (second level), with a bitmap over
+ * each level so a fitting list is found with two count-leading-zeros
+ * instructions. Freed blocks are merged with free neighbours at once.
+ *
+ * The heap is a static array of TLSF_HEAP_SIZE bytes. On MSP432 it is
+ * placed in the linker script's .heap region, between __heap_start__ and
+ * __heap_end__, ahead of the memory newlib's malloc grows into. The link
+ * fails if it reaches __StackLimit, the bottom of the stack. Building
+ * with -DMEM_ALLOC_TLSF (make ALLOCATOR=tlsf) makes it the backend of
+ * reserve_words and free_words. On MSP432 tlsf.c is only built then, so
+ * the heap does not take SRAM from malloc in other builds.
+ *
+ * @author Albert Olszewski
+ * @date October 17, 2026
+ *
+ */
+#ifndef __TLSF_H__
+#define __TLSF_H__
+
+#include <stdint.h>
+#include <stdlib.h>
+
+/* Defined when tlsf.c is part of the build */
+#if defined (HOST) || defined (MEM_ALLOC_TLSF)
+#define TLSF_AVAILABLE
+#endif
+
+/* Size of the heap in bytes, a multiple of 8. On MSP432 it shares the
+ * 56 KiB below the stack with .data, .bss and malloc. */
+#if !defined (TLSF_HEAP_SIZE)
+#if defined (MSP432)
+#define TLSF_HEAP_SIZE (16u * 1024u)
+#else
+#define TLSF_HEAP_SIZE (1024u * 1024u)
+#endif
+#endif
+
+/* Second level lists per power of two, as a power of two */
+#define TLSF_SL_LOG2   (4)
+
+/* Blocks are smaller than 2^TLSF_FL_MAX bytes, which must cover the heap */
+#if !defined (TLSF_FL_MAX)
+#if defined (MSP432)
+#define TLSF_FL_MAX    (16)
+#else
+#define TLSF_FL_MAX    (24)
+#endif
+#endif
+
+/**
+ * @brief Allocates memory from the heap
+ *
+ * @param length Number of bytes needed
+ *
+ * @return Pointer to 8-byte aligned memory, or NULL if no free block is
+ * large enough.
+ */
+void * tlsf_alloc(size_t length);
+
+/**
+ * @brief Returns memory to the heap
+ *
+ * The block is merged with any free block on either side before it is
+ * filed, so the heap does not fragment into small free blocks.
+ *
+ * @param ptr Pointer from tlsf_alloc, NULL is ignored
+ *
+ * @return void
+ */
+void tlsf_free(void * ptr);
+
+/**
+ * @brief Tells whether a pointer is inside the heap
+ *
+ * @param ptr Any pointer
+ *
+ * @return 1 if ptr is inside the heap, 0 otherwise.
+ */
+uint8_t tlsf_owns(void * ptr);
+
+/**
+ * @brief Walks the heap and checks its structure
+ *
+ * Meant for tests; it takes time proportional to the number of blocks.
+ *
+ * @return Number of free blocks, or -1 if the heap is inconsistent: two
+ * neighbouring free blocks, a broken neighbour link, or a free block that
+ * is not on the list for its size.
+ */
+int32_t tlsf_check(void);
+
+#endif /* __TLSF_H__ */
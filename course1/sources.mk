@@ -14,6 +14,14 @@ ifeq ($(PLATFORM), HOST)
 SOURCES = \
   src/main.c \
   src/memory.c \
+  src/crc.c \
+  src/hash.c \
+  src/dma.c \
+  src/pool.c \
+  src/arena.c \
+  src/slab.c \
+  src/tlsf.c \
+  src/bench.c \
   src/course1.c \
   src/data.c \
   src/stats.c
@@ -27,6 +35,11 @@ else ifeq ($(PLATFORM), MSP432)
 SOURCES = \
   src/main.c \
   src/memory.c \
+  src/crc.c \
+  src/hash.c \
+  src/dma.c \
+  src/arena.c \
+  src/bench.c \
   src/interrupts_msp432p401r_gcc.c \
   src/startup_msp432p401r_gcc.c \
   src/system_msp432p401r.c \
@@ -39,6 +52,14 @@ INCLUDES = \
   -Iinclude/msp432 \
   -Iinclude/CMSIS
 
+# the pool's blocks and the TLSF heap sit in .heap, only build the one
+# that is the backend
+ifeq ($(ALLOCATOR), pool)
+SOURCES += src/pool.c
+else ifeq ($(ALLOCATOR), tlsf)
+SOURCES += src/tlsf.c
+endif
+
 endif
 
 
@@ -0,0 +1,62 @@
+/******************************************************************************
+ * Copyright (C) 2025 by Albert Olszewski
+ *
+ * Redistribution, modification or use of this software in source or binary
+ * forms is permitted as long as the files maintain this copyright. Users are
+ * permitted to modify this and use it to learn about the field of embedded
+ * software. Alex Fosdick and the University of Colorado are not liable for any
+ * misuse of this material.
+ *
+ *****************************************************************************/
+/**
+ * @file arena.c
+ * @brief Arena (bump) allocator for short lived buffers
+ *
+ * The arena is an offset into the region, so a mark is just that offset
+ * and a reset is a single store.
+ *
+ * @author Albert Olszewski
+ * @date October 17, 2026
+ *
+ */
+#include "arena.h"
+#include <stdint.h>
+#include <stdlib.h>
+
+/***********************************************************
+ Function Definitions
+***********************************************************/
+void arena_init(arena_t * arena, uint8_t * region, size_t size) {
+  arena->base = region;
+  arena->size = size;
+  arena->used = 0;
+}
+
+void * arena_alloc(arena_t * arena, size_t length, size_t alignment) {
+  uintptr_t top;
+  size_t start;
+
+  if (alignment == 0 || (alignment & (alignment - 1)) != 0) {
+    return NULL;
+  }
+  // align the address itself, the region may start anywhere
+  top = (uintptr_t)arena->base + arena->used;
+  start = arena->used + (size_t)((alignment - (top & (alignment - 1))) & (alignment - 1));
+  if (start > arena->size || length > arena->size - start) {
+    return NULL;
+  }
+  arena->used = start + length;
+  return arena->base + start;
+}
+
+arena_mark_t arena_mark(const arena_t * arena) {
+  return arena->used;
+}
+
+void arena_reset_to(arena_t * arena, arena_mark_t mark) {
+  arena->used = mark;
+}
+
+size_t arena_remaining(const arena_t * arena) {
+  return arena->size - arena->used;
+}
@@ -0,0 +1,362 @@
+/******************************************************************************
+ * Copyright (C) 2025 by Albert Olszewski
+ *
+ * Redistribution, modification or use of this software in source or binary
+ * forms is permitted as long as the files maintain this copyright. Users are
+ * permitted to modify this and use it to learn about the field of embedded
+ * software. Alex Fosdick and the University of Colorado are not liable for any
+ * misuse of this material.
+ *
+ *****************************************************************************/
+/**
+ * @file bench.c
+ * @brief Throughput benchmarks
+ *
+ * Times the data functions over buffers from reserve_words and prints the
+ * results.
+ *
+ * @author Albert Olszewski
+ * @date October 17, 2026
+ *
+ */
+// clock_gettime is POSIX, not C99
+#if defined (HOST)
+#define _POSIX_C_SOURCE 199309L
+#include <time.h>
+#endif
+
+#include <stdint.h>
+#include <stdlib.h>
+#include "bench.h"
+#include "platform.h"
+#include "memory.h"
+#include "crc.h"
+#include "hash.h"
+#include "arena.h"
+#include "tlsf.h"
+
+// results are written here so the measured loops are not optimized away
+static volatile uint32_t bench_sink;
+
+volatile bench_result_t bench_results[BENCH_RESULTS_MAX];
+volatile uint32_t bench_result_count = 0;
+
+/***********************************************************
+ Timing
+***********************************************************/
+bench_tick_t bench_ticks(void) {
+#if defined (MSP432)
+  static uint8_t started = 0;
+
+  if (!started) {
+    CoreDebug->DEMCR |= CoreDebug_DEMCR_TRCENA_Msk;
+    DWT->CYCCNT = 0;
+    DWT->CTRL |= DWT_CTRL_CYCCNTENA_Msk;
+    started = 1;
+  }
+  return DWT->CYCCNT;
+#else
+  struct timespec ts;
+
+  clock_gettime(CLOCK_MONOTONIC, &ts);
+  return (bench_tick_t)ts.tv_sec * 1000000000u + (bench_tick_t)ts.tv_nsec;
+#endif
+}
+
+static void bench_record(const char * name, uint64_t value, uint64_t worst) {
+  if (bench_result_count < BENCH_RESULTS_MAX) {
+    bench_results[bench_result_count].name = name;
+    bench_results[bench_result_count].value = (value > UINT32_MAX) ? UINT32_MAX : (uint32_t)value;
+    bench_results[bench_result_count].worst = (worst > UINT32_MAX) ? UINT32_MAX : (uint32_t)worst;
+    bench_result_count++;
+  }
+}
+
+void bench_report(const char * name, uint64_t bytes, bench_tick_t ticks) {
+  uint64_t value;
+
+  if (ticks == 0) {
+    ticks = 1;
+  }
+#if defined (MSP432)
+  // cycles per 100 bytes keeps two decimals without floating point
+  value = ((uint64_t)ticks * 100u) / bytes;
+  PRINTF("  %-20s %8lu cycles/100B\n", name, (unsigned long)value);
+#else
+  // bytes per nanosecond * 1000 is MB/s
+  value = (bytes * 1000u) / ticks;
+  PRINTF("  %-20s %8llu MB/s\n", name, (unsigned long long)value);
+#endif
+  bench_record(name, value, 0);
+}
+
+void bench_report_ops(const char * name, uint64_t ops, bench_tick_t ticks) {
+  if (ops == 0) {
+    ops = 1;
+  }
+#if defined (MSP432)
+  PRINTF("  %-20s %8lu cycles/op\n", name, (unsigned long)(ticks / ops));
+#else
+  PRINTF("  %-20s %8llu ns/op\n", name, (unsigned long long)(ticks / ops));
+#endif
+  bench_record(name, ticks / ops, 0);
+}
+
+void bench_report_worst(const char * name, uint64_t ops, bench_tick_t ticks, bench_tick_t worst) {
+  if (ops == 0) {
+    ops = 1;
+  }
+#if defined (MSP432)
+  PRINTF("  %-20s %8lu cycles/op %8lu worst\n", name, (unsigned long)(ticks / ops), (unsigned long)worst);
+#else
+  PRINTF("  %-20s %8llu ns/op %8llu worst\n", name, (unsigned long long)(ticks / ops),
+         (unsigned long long)worst);
+#endif
+  bench_record(name, ticks / ops, worst);
+}
+
+/***********************************************************
+ Benchmarks
+***********************************************************/
+void bench_crc(void) {
+  uint8_t * buf;
+  uint32_t crc;
+  bench_tick_t start;
+  crc_impl_t best = crc_impl();
+  size_t i;
+
+  buf = (uint8_t *)reserve_words(BENCH_SIZE_W);
+  if (buf == NULL) {
+    return;
+  }
+  for (i = 0; i < BENCH_SIZE_B; i++) {
+    buf[i] = (uint8_t)(i * 31 + (i >> 8));
+  }
+
+  PRINTF("bench_crc()\n");
+  crc = 0;
+  start = bench_ticks();
+  for (i = 0; i < BENCH_ROUNDS; i++) {
+    crc = crc32_update(buf, BENCH_SIZE_B, crc);
+  }
+  bench_report("crc32 table", (uint64_t)BENCH_ROUNDS * BENCH_SIZE_B, bench_ticks() - start);
+  bench_sink = crc;
+
+  crc_select(CRC_IMPL_TABLE);
+  crc = 0;
+  start = bench_ticks();
+  for (i = 0; i < BENCH_ROUNDS; i++) {
+    crc = crc32c_update(buf, BENCH_SIZE_B, crc);
+  }
+  bench_report("crc32c table", (uint64_t)BENCH_ROUNDS * BENCH_SIZE_B, bench_ticks() - start);
+  bench_sink = crc;
+
+  if (crc_select(CRC_IMPL_HW) == CRC_IMPL_HW) {
+    crc = 0;
+    start = bench_ticks();
+    for (i = 0; i < BENCH_ROUNDS; i++) {
+      crc = crc32c_update(buf, BENCH_SIZE_B, crc);
+    }
+    bench_report("crc32c hw", (uint64_t)BENCH_ROUNDS * BENCH_SIZE_B, bench_ticks() - start);
+    bench_sink = crc;
+  }
+
+  crc_select(best);
+  free_words((int32_t *)buf);
+}
+
+void bench_hash(void) {
+  uint8_t * buf;
+  uint64_t h;
+  bench_tick_t start;
+  size_t i;
+
+  buf = (uint8_t *)reserve_words(BENCH_SIZE_W);
+  if (buf == NULL) {
+    return;
+  }
+  for (i = 0; i < BENCH_SIZE_B; i++) {
+    buf[i] = (uint8_t)(i * 31 + (i >> 8));
+  }
+
+  PRINTF("bench_hash()\n");
+  h = 0;
+  start = bench_ticks();
+  for (i = 0; i < BENCH_ROUNDS; i++) {
+    h = hash64(buf, BENCH_SIZE_B, h);
+  }
+  bench_report("hash64", (uint64_t)BENCH_ROUNDS * BENCH_SIZE_B, bench_ticks() - start);
+  bench_sink = (uint32_t)h;
+
+  // a copy is the bandwidth bound the hash is measured against
+  start = bench_ticks();
+  for (i = 0; i < BENCH_ROUNDS; i++) {
+    my_memcopy(buf, buf + BENCH_SIZE_B / 2, BENCH_SIZE_B / 2);
+  }
+  bench_report("memcopy", (uint64_t)BENCH_ROUNDS * BENCH_SIZE_B / 2, bench_ticks() - start);
+
+  free_words((int32_t *)buf);
+}
+
+void bench_xlat(void) {
+  uint8_t * buf;
+  uint8_t table[256];
+  bench_tick_t start;
+  mem_impl_t previous = my_mem_impl();
+  size_t i;
+
+  buf = (uint8_t *)reserve_words(BENCH_SIZE_W);
+  if (buf == NULL) {
+    return;
+  }
+  for (i = 0; i < BENCH_SIZE_B; i++) {
+    buf[i] = (uint8_t)(i * 31 + (i >> 8));
+  }
+  for (i = 0; i < sizeof(table); i++) {
+    table[i] = (uint8_t)(255 - i * 7);
+  }
+
+  PRINTF("bench_xlat()\n");
+  my_mem_select(MEM_IMPL_SCALAR);
+  start = bench_ticks();
+  for (i = 0; i < BENCH_ROUNDS; i++) {
+    my_memxlat(buf, buf + BENCH_SIZE_B / 2, BENCH_SIZE_B / 2, table);
+  }
+  bench_report("memxlat scalar", (uint64_t)BENCH_ROUNDS * BENCH_SIZE_B / 2, bench_ticks() - start);
+
+  // the widest kernels this cpu can run
+  if (my_mem_select(MEM_IMPL_AVX2) != MEM_IMPL_SCALAR) {
+    start = bench_ticks();
+    for (i = 0; i < BENCH_ROUNDS; i++) {
+      my_memxlat(buf, buf + BENCH_SIZE_B / 2, BENCH_SIZE_B / 2, table);
+    }
+    bench_report("memxlat vector", (uint64_t)BENCH_ROUNDS * BENCH_SIZE_B / 2, bench_ticks() - start);
+  }
+  bench_sink = buf[BENCH_SIZE_B - 1];
+
+  my_mem_select(previous);
+  free_words((int32_t *)buf);
+}
+
+void bench_alloc(void) {
+  int32_t * bufs[BENCH_FRAME_BUFFERS];
+  uint8_t * region;
+  arena_t arena;
+  bench_tick_t start;
+  size_t frame, i;
+  uint32_t failed = 0;
+
+  // room for one frame of the largest sizes below
+  region = (uint8_t *)reserve_words(BENCH_FRAME_BUFFERS * BENCH_FRAME_WORDS);
+  if (region == NULL) {
+    return;
+  }
+
+  // a failed allocation is timed like any other, then skipped
+  PRINTF("bench_alloc()\n");
+  start = bench_ticks();
+  for (frame = 0; frame < BENCH_FRAMES; frame++) {
+    for (i = 0; i < BENCH_FRAME_BUFFERS; i++) {
+      bufs[i] = reserve_words((i * 37 + frame) % BENCH_FRAME_WORDS + 1);
+      if (bufs[i] != NULL) {
+        bufs[i][0] = (int32_t)i;
+      }
+    }
+    for (i = 0; i < BENCH_FRAME_BUFFERS; i++) {
+      if (bufs[i] != NULL) {
+        bench_sink += (uint32_t)bufs[i][0];
+        free_words(bufs[i]);
+      } else {
+        failed++;
+      }
+    }
+  }
+  bench_report_ops("reserve_words", (uint64_t)BENCH_FRAMES * BENCH_FRAME_BUFFERS, bench_ticks() - start);
+  if (failed > 0) {
+    PRINTF("  %-20s %8lu failed\n", "reserve_words", (unsigned long)failed);
+  }
+
+  // a frame never needs more than the region, so these cannot fail
+  arena_init(&arena, region, BENCH_FRAME_BUFFERS * BENCH_FRAME_WORDS * sizeof(int32_t));
+  start = bench_ticks();
+  for (frame = 0; frame < BENCH_FRAMES; frame++) {
+    for (i = 0; i < BENCH_FRAME_BUFFERS; i++) {
+      bufs[i] = (int32_t *)arena_alloc(&arena, ((i * 37 + frame) % BENCH_FRAME_WORDS + 1) * sizeof(int32_t),
+                                       sizeof(int32_t));
+      bufs[i][0] = (int32_t)i;
+    }
+    for (i = 0; i < BENCH_FRAME_BUFFERS; i++) {
+      bench_sink += (uint32_t)bufs[i][0];
+    }
+    arena_reset_to(&arena, 0);
+  }
+  bench_report_ops("arena_alloc", (uint64_t)BENCH_FRAMES * BENCH_FRAME_BUFFERS, bench_ticks() - start);
+
+  free_words((int32_t *)region);
+}
+
+typedef struct {
+  bench_tick_t total;
+  bench_tick_t worst;
+  uint64_t ops;
+} bench_stress_t;
+
+static void bench_stress_add(bench_stress_t * s, bench_tick_t ticks) {
+  s->total += ticks;
+  s->ops++;
+  if (ticks > s->worst) {
+    s->worst = ticks;
+  }
+}
+
+// the same random sequence for both allocators; a failed allocation is
+// timed like any other
+static void bench_stress(const char * alloc_name, const char * free_name,
+                         void * (*alloc)(size_t), void (*release)(void *)) {
+  void * slots[BENCH_STRESS_SLOTS] = { NULL };
+  bench_stress_t allocs = { 0, 0, 0 };
+  bench_stress_t frees = { 0, 0, 0 };
+  bench_tick_t start;
+  uint32_t seed = 1;
+  size_t i, s;
+
+  for (i = 0; i < BENCH_STRESS_OPS; i++) {
+    seed = seed * 1664525u + 1013904223u;
+    s = (seed >> 8) % BENCH_STRESS_SLOTS;
+    if (slots[s] != NULL) {
+      start = bench_ticks();
+      release(slots[s]);
+      bench_stress_add(&frees, bench_ticks() - start);
+      slots[s] = NULL;
+    } else {
+      start = bench_ticks();
+      slots[s] = alloc((seed >> 20) % 1024 + 1);
+      bench_stress_add(&allocs, bench_ticks() - start);
+      if (slots[s] != NULL) {
+        *(volatile uint8_t *)slots[s] = (uint8_t)i;
+      }
+    }
+  }
+  for (s = 0; s < BENCH_STRESS_SLOTS; s++) {
+    release(slots[s]);
+  }
+
+  bench_report_worst(alloc_name, allocs.ops, allocs.total, allocs.worst);
+  bench_report_worst(free_name, frees.ops, frees.total, frees.worst);
+}
+
+void bench_tlsf(void) {
+  PRINTF("bench_tlsf()\n");
+#if defined (TLSF_AVAILABLE)
+  bench_stress("tlsf_alloc", "tlsf_free", tlsf_alloc, tlsf_free);
+#endif
+  bench_stress("malloc", "free", malloc, free);
+}
+
+void bench(void) {
+  bench_crc();
+  bench_hash();
+  bench_xlat();
+  bench_alloc();
+  bench_tlsf();
+}
@@ -23,6 +23,16 @@
 #include "data.h"
 #include "course1.h"
 #include "memory.h"
+#include "crc.h"
+#include "hash.h"
+#include "dma.h"
+#include "pool.h"
+#include "arena.h"
+#include "tlsf.h"
+#if defined (HOST)
+#include <pthread.h>
+#include "slab.h"
+#endif
 #include "stats.h"
 
 int8_t test_data1() {
@@ -324,6 +334,1678 @@ int8_t test_reverse()
   return ret;
 }
 
+int8_t test_memmove_unaligned()
+{
+  size_t s, d, n, i;
+  int8_t ret = TEST_NO_ERROR;
+  mem_impl_t impl;
+  mem_impl_t best = my_mem_impl();
+  uint8_t * set;
+  uint8_t * ref;
+
+  PRINTF("test_memmove_unaligned()\n");
+  set = (uint8_t*)reserve_words(MEM_WIDE_SIZE_W);
+  ref = (uint8_t*)reserve_words(MEM_WIDE_SIZE_W);
+  if (! set || ! ref )
+  {
+    free_words( (int32_t*)set );
+    free_words( (int32_t*)ref );
+    return TEST_ERROR;
+  }
+
+  /* Every kernel family, source/destination misalignment and overlap */
+  for (impl = MEM_IMPL_SCALAR; impl <= best; impl++)
+  {
+    my_mem_select(impl);
+    for (s = 0; s < MEM_WIDE_OFFSETS; s++)
+    {
+      for (d = 0; d < MEM_WIDE_OFFSETS; d++)
+      {
+        for (n = 0; n <= MEM_WIDE_LENGTH; n++)
+        {
+          for (i = 0; i < MEM_WIDE_SIZE_B; i++)
+          {
+            set[i] = (uint8_t)i;
+            ref[i] = (uint8_t)i;
+          }
+
+          /* Byte at a time reference in the safe direction */
+          if (s < d)
+          {
+            for (i = n; i > 0; i--)
+            {
+              ref[d + i - 1] = ref[s + i - 1];
+            }
+          }
+          else
+          {
+            for (i = 0; i < n; i++)
+            {
+              ref[d + i] = ref[s + i];
+            }
+          }
+
+          my_memmove(&set[s], &set[d], n);
+          for (i = 0; i < MEM_WIDE_SIZE_B; i++)
+          {
+            if (set[i] != ref[i])
+            {
+              ret = TEST_ERROR;
+            }
+          }
+
+          /* Non-overlapping copy into the second buffer */
+          my_memcopy(&set[s], &ref[d + MEM_WIDE_OFFSETS], n);
+          for (i = 0; i < n; i++)
+          {
+            if (ref[d + MEM_WIDE_OFFSETS + i] != set[s + i])
+            {
+              ret = TEST_ERROR;
+            }
+          }
+        }
+      }
+    }
+  }
+  my_mem_select(best);
+
+  free_words( (int32_t*)set );
+  free_words( (int32_t*)ref );
+  return ret;
+}
+
+int8_t test_memset_unaligned()
+{
+  size_t d, n, i;
+  int8_t ret = TEST_NO_ERROR;
+  mem_impl_t impl;
+  mem_impl_t best = my_mem_impl();
+  size_t threshold;
+  uint8_t * set;
+
+  PRINTF("test_memset_unaligned()\n");
+  set = (uint8_t*)reserve_words(MEM_WIDE_SIZE_W);
+  if (! set )
+  {
+    return TEST_ERROR;
+  }
+
+  /* Every kernel family must only touch the requested bytes, the longer
+   * lengths take the streaming path */
+  threshold = my_mem_set_stream_threshold(MEM_WIDE_LENGTH / 2);
+  for (impl = MEM_IMPL_SCALAR; impl <= best; impl++)
+  {
+    my_mem_select(impl);
+    for (d = 0; d < MEM_WIDE_OFFSETS; d++)
+    {
+      for (n = 0; n <= MEM_WIDE_LENGTH; n++)
+      {
+        for (i = 0; i < MEM_WIDE_SIZE_B; i++)
+        {
+          set[i] = (uint8_t)i;
+        }
+
+        my_memset(&set[d], n, 0xA5);
+        for (i = 0; i < MEM_WIDE_SIZE_B; i++)
+        {
+          if (set[i] != ((i >= d && i < d + n) ? 0xA5 : (uint8_t)i))
+          {
+            ret = TEST_ERROR;
+          }
+        }
+
+        my_memzero(&set[d], n);
+        for (i = 0; i < MEM_WIDE_SIZE_B; i++)
+        {
+          if (set[i] != ((i >= d && i < d + n) ? 0 : (uint8_t)i))
+          {
+            ret = TEST_ERROR;
+          }
+        }
+
+        my_memset(&set[d], n, 0xA5);
+        my_memzero_stream(&set[d], n);
+        for (i = 0; i < MEM_WIDE_SIZE_B; i++)
+        {
+          if (set[i] != ((i >= d && i < d + n) ? 0 : (uint8_t)i))
+          {
+            ret = TEST_ERROR;
+          }
+        }
+      }
+    }
+  }
+  my_mem_set_stream_threshold(threshold);
+  my_mem_select(best);
+
+  free_words( (int32_t*)set );
+  return ret;
+}
+
+int8_t test_reverse_unaligned()
+{
+  size_t d, n, i;
+  int8_t ret = TEST_NO_ERROR;
+  mem_impl_t impl;
+  mem_impl_t best = my_mem_impl();
+  uint8_t * set;
+
+  PRINTF("test_reverse_unaligned()\n");
+  set = (uint8_t*)reserve_words(MEM_WIDE_SIZE_W);
+  if (! set )
+  {
+    return TEST_ERROR;
+  }
+
+  /* Odd and even lengths at every offset, for every kernel family */
+  for (impl = MEM_IMPL_SCALAR; impl <= best; impl++)
+  {
+    my_mem_select(impl);
+    for (d = 0; d < MEM_WIDE_OFFSETS; d++)
+    {
+      for (n = 0; n <= MEM_WIDE_LENGTH; n++)
+      {
+        for (i = 0; i < MEM_WIDE_SIZE_B; i++)
+        {
+          set[i] = (uint8_t)i;
+        }
+
+        my_reverse(&set[d], n);
+        for (i = 0; i < MEM_WIDE_SIZE_B; i++)
+        {
+          if (set[i] != ((i >= d && i < d + n) ? (uint8_t)(2 * d + n - 1 - i) : (uint8_t)i))
+          {
+            ret = TEST_ERROR;
+          }
+        }
+      }
+    }
+  }
+  my_mem_select(best);
+
+  free_words( (int32_t*)set );
+  return ret;
+}
+
+int8_t test_memcopy_mt()
+{
+  size_t i;
+  int8_t ret = TEST_NO_ERROR;
+  size_t threads;
+  size_t threshold;
+  uint8_t * src;
+  uint8_t * dst;
+
+  PRINTF("test_memcopy_mt()\n");
+  src = (uint8_t*)reserve_words(MEM_MT_SIZE_W);
+  dst = (uint8_t*)reserve_words(MEM_MT_SIZE_W);
+  if (! src || ! dst )
+  {
+    free_words( (int32_t*)src );
+    free_words( (int32_t*)dst );
+    return TEST_ERROR;
+  }
+
+  /* Force the threaded path with an odd split and misaligned pointers */
+  threads = my_mem_set_threads(MEM_MT_THREADS_TEST);
+  threshold = my_mem_set_mt_threshold(0);
+
+  for (i = 0; i < MEM_MT_SIZE_B; i++)
+  {
+    src[i] = (uint8_t)(i * 7);
+  }
+  my_memzero_mt(dst, MEM_MT_SIZE_B);
+  my_memcopy_mt(&src[1], &dst[3], MEM_MT_SIZE_B - 3);
+  for (i = 0; i < MEM_MT_SIZE_B - 3; i++)
+  {
+    if (dst[i + 3] != (uint8_t)((i + 1) * 7))
+    {
+      ret = TEST_ERROR;
+    }
+  }
+
+  my_memset_mt(&dst[5], MEM_MT_SIZE_B - 10, 0x3C);
+  for (i = 0; i < MEM_MT_SIZE_B; i++)
+  {
+    if (i >= 5 && i < MEM_MT_SIZE_B - 5 && dst[i] != 0x3C)
+    {
+      ret = TEST_ERROR;
+    }
+  }
+  if (dst[0] != 0 || dst[4] != (uint8_t)(2 * 7) || dst[MEM_MT_SIZE_B - 1] != (uint8_t)((MEM_MT_SIZE_B - 3) * 7))
+  {
+    ret = TEST_ERROR;
+  }
+
+  my_mem_set_mt_threshold(threshold);
+  my_mem_set_threads(threads);
+
+  free_words( (int32_t*)src );
+  free_words( (int32_t*)dst );
+  return ret;
+}
+
+int8_t test_reverse_elements()
+{
+  size_t w, d, n, i, e, b;
+  int8_t ret = TEST_NO_ERROR;
+  mem_impl_t impl;
+  mem_impl_t best = my_mem_impl();
+  uint8_t * set;
+
+  PRINTF("test_reverse_elements()\n");
+  set = (uint8_t*)reserve_words(MEM_WIDE_SIZE_W);
+  if (! set )
+  {
+    return TEST_ERROR;
+  }
+
+  /* 16, 32 and 64-bit elements, element order and then byte order */
+  for (impl = MEM_IMPL_SCALAR; impl <= best; impl++)
+  {
+    my_mem_select(impl);
+    for (w = 2; w <= 8; w *= 2)
+    {
+      for (d = 0; d < 4; d++)
+      {
+        for (n = 0; (d + n) * w <= MEM_WIDE_SIZE_B / 2; n++)
+        {
+          for (i = 0; i < MEM_WIDE_SIZE_B; i++)
+          {
+            set[i] = (uint8_t)i;
+          }
+
+          if (w == 2)
+          {
+            my_reverse16((uint16_t*)set + d, n);
+          }
+          else if (w == 4)
+          {
+            my_reverse32((uint32_t*)set + d, n);
+          }
+          else
+          {
+            my_reverse64((uint64_t*)set + d, n);
+          }
+          for (e = d; e < d + n; e++)
+          {
+            for (b = 0; b < w; b++)
+            {
+              if (set[e * w + b] != (uint8_t)((2 * d + n - 1 - e) * w + b))
+              {
+                ret = TEST_ERROR;
+              }
+            }
+          }
+
+          if (w == 2)
+          {
+            my_bswap16_array((uint16_t*)set + d, n);
+          }
+          else if (w == 4)
+          {
+            my_bswap32_array((uint32_t*)set + d, n);
+          }
+          else
+          {
+            my_bswap64_array((uint64_t*)set + d, n);
+          }
+          for (e = d; e < d + n; e++)
+          {
+            for (b = 0; b < w; b++)
+            {
+              if (set[e * w + b] != (uint8_t)((2 * d + n - 1 - e) * w + (w - 1 - b)))
+              {
+                ret = TEST_ERROR;
+              }
+            }
+          }
+          if (set[(d + n) * w] != (uint8_t)((d + n) * w))
+          {
+            ret = TEST_ERROR;
+          }
+        }
+      }
+    }
+  }
+  my_mem_select(best);
+
+  free_words( (int32_t*)set );
+  return ret;
+}
+
+int8_t test_memfill_pattern()
+{
+  size_t d, n, i, p;
+  int8_t ret = TEST_NO_ERROR;
+  mem_impl_t impl;
+  mem_impl_t best = my_mem_impl();
+  uint8_t pattern[MEM_PATTERN_MAX];
+  uint8_t * set;
+
+  PRINTF("test_memfill_pattern()\n");
+  set = (uint8_t*)reserve_words(MEM_WIDE_SIZE_W);
+  if (! set )
+  {
+    return TEST_ERROR;
+  }
+  for (i = 0; i < MEM_PATTERN_MAX; i++)
+  {
+    pattern[i] = (uint8_t)(0xC0 + i);
+  }
+
+  for (impl = MEM_IMPL_SCALAR; impl <= best; impl++)
+  {
+    my_mem_select(impl);
+    for (d = 0; d < MEM_WIDE_OFFSETS; d++)
+    {
+      for (n = 0; n <= MEM_WIDE_LENGTH; n += 3)
+      {
+        /* Arbitrary pattern lengths, broadcast and doubled */
+        for (p = 1; p <= MEM_PATTERN_MAX; p++)
+        {
+          for (i = 0; i < MEM_WIDE_SIZE_B; i++)
+          {
+            set[i] = (uint8_t)i;
+          }
+          my_memfill_pattern(&set[d], n, pattern, p);
+          for (i = 0; i < MEM_WIDE_SIZE_B; i++)
+          {
+            if (set[i] != ((i >= d && i < d + n) ? pattern[(i - d) % p] : (uint8_t)i))
+            {
+              ret = TEST_ERROR;
+            }
+          }
+        }
+
+        /* Element fills, the offset is in elements to keep them aligned */
+        my_memzero(set, MEM_WIDE_SIZE_B);
+        my_memset16((uint16_t*)set + d, n / 2, 0xBEEF);
+        for (i = 0; i <= n / 2; i++)
+        {
+          if (((uint16_t*)set)[d + i] != ((i < n / 2) ? 0xBEEF : 0))
+          {
+            ret = TEST_ERROR;
+          }
+        }
+
+        my_memzero(set, MEM_WIDE_SIZE_B);
+        my_memset32((uint32_t*)set + d, n / 4, 0xDEADBEEF);
+        for (i = 0; i <= n / 4; i++)
+        {
+          if (((uint32_t*)set)[d + i] != ((i < n / 4) ? 0xDEADBEEF : 0))
+          {
+            ret = TEST_ERROR;
+          }
+        }
+
+        my_memzero(set, MEM_WIDE_SIZE_B);
+        my_memset64((uint64_t*)set + d / 2, n / 8, 0x0123456789ABCDEFull);
+        for (i = 0; i <= n / 8; i++)
+        {
+          if (((uint64_t*)set)[d / 2 + i] != ((i < n / 8) ? 0x0123456789ABCDEFull : 0))
+          {
+            ret = TEST_ERROR;
+          }
+        }
+      }
+    }
+  }
+  my_mem_select(best);
+
+  free_words( (int32_t*)set );
+  return ret;
+}
+
+int8_t test_memcmp()
+{
+  size_t d, n, k, i;
+  int8_t ret = TEST_NO_ERROR;
+  mem_impl_t impl;
+  mem_impl_t best = my_mem_impl();
+  uint8_t * set;
+  uint8_t * ref;
+
+  PRINTF("test_memcmp()\n");
+  set = (uint8_t*)reserve_words(MEM_WIDE_SIZE_W);
+  ref = (uint8_t*)reserve_words(MEM_WIDE_SIZE_W);
+  if (! set || ! ref )
+  {
+    free_words( (int32_t*)set );
+    free_words( (int32_t*)ref );
+    return TEST_ERROR;
+  }
+  /* 0xFF only appears past the end of any range searched below */
+  for (i = 0; i < MEM_WIDE_SIZE_B; i++)
+  {
+    set[i] = (uint8_t)i;
+    ref[i] = (uint8_t)i;
+  }
+
+  for (impl = MEM_IMPL_SCALAR; impl <= best; impl++)
+  {
+    my_mem_select(impl);
+    for (d = 0; d < MEM_WIDE_OFFSETS; d++)
+    {
+      for (n = 0; n <= MEM_WIDE_LENGTH; n++)
+      {
+        if (my_memdiff(&set[d], &ref[d], n) != n || my_memcmp(&set[d], &ref[d], n) != 0 ||
+            my_memchr(&set[d], n, 0xFF) != NULL || my_memrchr(&set[d], n, 0xFF) != NULL)
+        {
+          ret = TEST_ERROR;
+        }
+
+        /* A single difference or match at every position */
+        for (k = 0; k < n; k++)
+        {
+          ref[d + k] ^= 0x80;
+          if (my_memdiff(&set[d], &ref[d], n) != k ||
+              (my_memcmp(&set[d], &ref[d], n) < 0) != (set[d + k] < ref[d + k]))
+          {
+            ret = TEST_ERROR;
+          }
+          ref[d + k] ^= 0x80;
+
+          set[d + k] = 0xFF;
+          if (my_memchr(&set[d], n, 0xFF) != &set[d + k] ||
+              my_memrchr(&set[d], n, 0xFF) != &set[d + k])
+          {
+            ret = TEST_ERROR;
+          }
+          /* A second match at the end only moves the last one */
+          set[d + n - 1] = 0xFF;
+          if (my_memchr(&set[d], n, 0xFF) != &set[d + k] ||
+              my_memrchr(&set[d], n, 0xFF) != &set[d + n - 1])
+          {
+            ret = TEST_ERROR;
+          }
+          set[d + n - 1] = (uint8_t)(d + n - 1);
+          set[d + k] = (uint8_t)(d + k);
+        }
+      }
+    }
+  }
+  my_mem_select(best);
+
+  free_words( (int32_t*)set );
+  free_words( (int32_t*)ref );
+  return ret;
+}
+
+int8_t test_memswap()
+{
+  size_t s, d, n, i;
+  int8_t ret = TEST_NO_ERROR;
+  mem_impl_t impl;
+  mem_impl_t best = my_mem_impl();
+  uint8_t * set;
+  uint8_t * ref;
+
+  PRINTF("test_memswap()\n");
+  set = (uint8_t*)reserve_words(MEM_WIDE_SIZE_W);
+  ref = (uint8_t*)reserve_words(MEM_WIDE_SIZE_W);
+  if (! set || ! ref )
+  {
+    free_words( (int32_t*)set );
+    free_words( (int32_t*)ref );
+    return TEST_ERROR;
+  }
+
+  for (impl = MEM_IMPL_SCALAR; impl <= best; impl++)
+  {
+    my_mem_select(impl);
+    for (s = 0; s < MEM_WIDE_OFFSETS; s++)
+    {
+      for (d = 0; d < MEM_WIDE_OFFSETS; d++)
+      {
+        for (n = 0; n <= MEM_WIDE_LENGTH; n += 7)
+        {
+          for (i = 0; i < MEM_WIDE_SIZE_B; i++)
+          {
+            set[i] = (uint8_t)i;
+            ref[i] = (uint8_t)~i;
+          }
+
+          my_memswap(&set[s], &ref[d], n);
+          for (i = 0; i < MEM_WIDE_SIZE_B; i++)
+          {
+            if (set[i] != ((i >= s && i < s + n) ? (uint8_t)~(i - s + d) : (uint8_t)i) ||
+                ref[i] != ((i >= d && i < d + n) ? (uint8_t)(i - d + s) : (uint8_t)~i))
+            {
+              ret = TEST_ERROR;
+            }
+          }
+        }
+      }
+    }
+  }
+  my_mem_select(best);
+
+  free_words( (int32_t*)set );
+  free_words( (int32_t*)ref );
+  return ret;
+}
+
+int8_t test_rotate()
+{
+  size_t n, k, i;
+  int8_t ret = TEST_NO_ERROR;
+  uint8_t * set;
+
+  PRINTF("test_rotate()\n");
+  set = (uint8_t*)reserve_words(MEM_WIDE_SIZE_W);
+  if (! set )
+  {
+    return TEST_ERROR;
+  }
+
+  /* Every shift of every length, including shifts past the end */
+  for (n = 0; n <= MEM_WIDE_SIZE_B; n++)
+  {
+    for (k = 0; k <= n + 1; k++)
+    {
+      for (i = 0; i < MEM_WIDE_SIZE_B; i++)
+      {
+        set[i] = (uint8_t)i;
+      }
+
+      my_rotate(set, n, k);
+      for (i = 0; i < n; i++)
+      {
+        if (set[i] != (uint8_t)((i + k) % n))
+        {
+          ret = TEST_ERROR;
+        }
+      }
+      for (i = n; i < MEM_WIDE_SIZE_B; i++)
+      {
+        if (set[i] != (uint8_t)i)
+        {
+          ret = TEST_ERROR;
+        }
+      }
+    }
+  }
+
+  free_words( (int32_t*)set );
+  return ret;
+}
+
+int8_t test_memxlat()
+{
+  size_t d, n, i;
+  int8_t ret = TEST_NO_ERROR;
+  mem_impl_t impl;
+  mem_impl_t best = my_mem_impl();
+  uint8_t table[MEM_XLAT_TABLE_SIZE];
+  uint8_t * set;
+  uint8_t * ref;
+
+  PRINTF("test_memxlat()\n");
+  set = (uint8_t*)reserve_words(MEM_WIDE_SIZE_W);
+  ref = (uint8_t*)reserve_words(MEM_WIDE_SIZE_W);
+  if (! set || ! ref )
+  {
+    free_words( (int32_t*)set );
+    free_words( (int32_t*)ref );
+    return TEST_ERROR;
+  }
+  /* A table that is not its own inverse and touches every row and column */
+  for (i = 0; i < MEM_XLAT_TABLE_SIZE; i++)
+  {
+    table[i] = (uint8_t)(i * 167 + 13);
+  }
+
+  for (impl = MEM_IMPL_SCALAR; impl <= best; impl++)
+  {
+    my_mem_select(impl);
+    for (d = 0; d < MEM_WIDE_OFFSETS; d++)
+    {
+      for (n = 0; n <= MEM_WIDE_LENGTH; n++)
+      {
+        for (i = 0; i < MEM_WIDE_SIZE_B; i++)
+        {
+          set[i] = (uint8_t)(i * 29);
+          ref[i] = 0;
+        }
+
+        /* Copying form, then in place */
+        my_memxlat(&set[d], &ref[MEM_WIDE_OFFSETS - d], n, table);
+        my_memxlat(&set[d], &set[d], n, table);
+        for (i = 0; i < n; i++)
+        {
+          if (ref[MEM_WIDE_OFFSETS - d + i] != table[(uint8_t)((d + i) * 29)] ||
+              set[d + i] != table[(uint8_t)((d + i) * 29)])
+          {
+            ret = TEST_ERROR;
+          }
+        }
+        if (ref[MEM_WIDE_OFFSETS - d + n] != 0 || set[d + n] != (uint8_t)((d + n) * 29))
+        {
+          ret = TEST_ERROR;
+        }
+      }
+    }
+  }
+  my_mem_select(best);
+
+  free_words( (int32_t*)set );
+  free_words( (int32_t*)ref );
+  return ret;
+}
+
+int8_t test_interleave()
+{
+  size_t ch, n, c, i;
+  int8_t ret = TEST_NO_ERROR;
+  mem_impl_t impl;
+  mem_impl_t best = my_mem_impl();
+  uint8_t * planes8[MEM_CHANNELS_MAX];
+  uint16_t * planes16[MEM_CHANNELS_MAX];
+  uint8_t * set;
+  uint8_t * split;
+  uint8_t * join;
+
+  PRINTF("test_interleave()\n");
+  set = (uint8_t*)reserve_words(MEM_WIDE_SIZE_W);
+  split = (uint8_t*)reserve_words(MEM_WIDE_SIZE_W);
+  join = (uint8_t*)reserve_words(MEM_WIDE_SIZE_W);
+  if (! set || ! split || ! join )
+  {
+    free_words( (int32_t*)set );
+    free_words( (int32_t*)split );
+    free_words( (int32_t*)join );
+    return TEST_ERROR;
+  }
+  for (i = 0; i < MEM_WIDE_SIZE_B; i++)
+  {
+    set[i] = (uint8_t)(i * 11 + 5);
+  }
+
+  /* Split then join again for 1 to MEM_CHANNELS_MAX channels */
+  for (impl = MEM_IMPL_SCALAR; impl <= best; impl++)
+  {
+    my_mem_select(impl);
+    for (ch = 1; ch <= MEM_CHANNELS_MAX; ch++)
+    {
+      for (c = 0; c < ch; c++)
+      {
+        planes8[c] = split + c * MEM_PLANE_SIZE_B;
+        planes16[c] = (uint16_t*)planes8[c];
+      }
+
+      /* 8-bit samples */
+      for (n = 0; n * ch <= MEM_WIDE_SIZE_B / 2 && n <= MEM_PLANE_SIZE_B; n++)
+      {
+        my_memzero(join, MEM_WIDE_SIZE_B);
+        my_deinterleave8(set, planes8, ch, n);
+        my_interleave8(planes8, join, ch, n);
+        for (i = 0; i < n * ch; i++)
+        {
+          if (planes8[i % ch][i / ch] != set[i] || join[i] != set[i])
+          {
+            ret = TEST_ERROR;
+          }
+        }
+        if (join[n * ch] != 0)
+        {
+          ret = TEST_ERROR;
+        }
+      }
+
+      /* 16-bit samples */
+      for (n = 0; n * ch <= MEM_WIDE_SIZE_B / 4 && 2 * n <= MEM_PLANE_SIZE_B; n++)
+      {
+        my_memzero(join, MEM_WIDE_SIZE_B);
+        my_deinterleave16((uint16_t*)set, planes16, ch, n);
+        my_interleave16(planes16, (uint16_t*)join, ch, n);
+        for (i = 0; i < n * ch; i++)
+        {
+          if (planes16[i % ch][i / ch] != ((uint16_t*)set)[i] ||
+              ((uint16_t*)join)[i] != ((uint16_t*)set)[i])
+          {
+            ret = TEST_ERROR;
+          }
+        }
+        if (((uint16_t*)join)[n * ch] != 0)
+        {
+          ret = TEST_ERROR;
+        }
+      }
+    }
+  }
+  my_mem_select(best);
+
+  free_words( (int32_t*)set );
+  free_words( (int32_t*)split );
+  free_words( (int32_t*)join );
+  return ret;
+}
+
+int8_t test_memcopyv()
+{
+  size_t i, n, offset;
+  int8_t ret = TEST_NO_ERROR;
+  mem_segment_t segs[MEM_SEGMENT_COUNT];
+  uint8_t * set;
+  uint8_t * packet;
+  uint8_t * back;
+
+  PRINTF("test_memcopyv()\n");
+  set = (uint8_t*)reserve_words(MEM_WIDE_SIZE_W * 4);
+  packet = (uint8_t*)reserve_words(MEM_WIDE_SIZE_W * 4);
+  back = (uint8_t*)reserve_words(MEM_WIDE_SIZE_W * 4);
+  if (! set || ! packet || ! back )
+  {
+    free_words( (int32_t*)set );
+    free_words( (int32_t*)packet );
+    free_words( (int32_t*)back );
+    return TEST_ERROR;
+  }
+  for (i = 0; i < MEM_WIDE_SIZE_B * 4; i++)
+  {
+    set[i] = (uint8_t)(i * 13);
+  }
+
+  /* Fragments of 0 to 90 bytes from scattered, misaligned places */
+  offset = 0;
+  n = 0;
+  for (i = 0; i < MEM_SEGMENT_COUNT; i++)
+  {
+    segs[i].ptr = &set[offset + i];
+    segs[i].length = (i * 37) % 91;
+    offset += segs[i].length;
+    n += segs[i].length;
+  }
+
+  if (my_memcopyv(packet, segs, MEM_SEGMENT_COUNT) != n)
+  {
+    ret = TEST_ERROR;
+  }
+  offset = 0;
+  for (i = 0; i < MEM_SEGMENT_COUNT; i++)
+  {
+    if (my_memcmp(segs[i].ptr, &packet[offset], segs[i].length) != 0)
+    {
+      ret = TEST_ERROR;
+    }
+    offset += segs[i].length;
+  }
+
+  /* Scatter the packet into a second buffer at the same spots */
+  my_memzero(back, MEM_WIDE_SIZE_B * 4);
+  for (i = 0; i < MEM_SEGMENT_COUNT; i++)
+  {
+    segs[i].ptr = back + (segs[i].ptr - set);
+  }
+  if (my_memscatterv(packet, segs, MEM_SEGMENT_COUNT) != n)
+  {
+    ret = TEST_ERROR;
+  }
+  for (i = 0; i < MEM_SEGMENT_COUNT; i++)
+  {
+    if (my_memcmp(segs[i].ptr, &set[segs[i].ptr - back], segs[i].length) != 0)
+    {
+      ret = TEST_ERROR;
+    }
+    /* The one byte gap between fragments is untouched */
+    if (segs[i].ptr[segs[i].length] != 0)
+    {
+      ret = TEST_ERROR;
+    }
+  }
+
+  free_words( (int32_t*)set );
+  free_words( (int32_t*)packet );
+  free_words( (int32_t*)back );
+  return ret;
+}
+
+int8_t test_memcopy_checksum()
+{
+  size_t n, i;
+  int8_t ret = TEST_NO_ERROR;
+  uint32_t crc;
+  uint32_t adler;
+  uint8_t check[] = "123456789";
+  uint8_t wiki[] = "Wikipedia";
+  uint8_t * set;
+  uint8_t * copy;
+
+  PRINTF("test_memcopy_checksum()\n");
+  set = (uint8_t*)reserve_words(MEM_MT_SIZE_W);
+  copy = (uint8_t*)reserve_words(MEM_MT_SIZE_W);
+  if (! set || ! copy )
+  {
+    free_words( (int32_t*)set );
+    free_words( (int32_t*)copy );
+    return TEST_ERROR;
+  }
+
+  /* Published check values */
+  if (my_crc32(check, 9, 0) != CRC32_CHECK || my_adler32(wiki, 9, 1) != ADLER32_WIKIPEDIA)
+  {
+    ret = TEST_ERROR;
+  }
+
+  /* Fused results match a copy followed by a separate pass, and chain */
+  for (i = 0; i < MEM_MT_SIZE_B; i++)
+  {
+    set[i] = (uint8_t)(i * 31 + (i >> 8));
+  }
+  for (n = 0; n <= MEM_MT_SIZE_B - 3; n += (n < 64) ? 1 : 4093)
+  {
+    my_memzero(copy, MEM_MT_SIZE_B);
+    crc = my_memcopy_crc32(&set[3], &copy[1], n, 0);
+    if (crc != my_crc32(&set[3], n, 0) || my_memcmp(&set[3], &copy[1], n) != 0 ||
+        crc != my_crc32(&set[3 + n / 2], n - n / 2, my_crc32(&set[3], n / 2, 0)))
+    {
+      ret = TEST_ERROR;
+    }
+
+    my_memzero(copy, MEM_MT_SIZE_B);
+    adler = my_memcopy_adler32(&set[3], &copy[1], n, 1);
+    if (adler != my_adler32(&set[3], n, 1) || my_memcmp(&set[3], &copy[1], n) != 0 ||
+        adler != my_adler32(&set[3 + n / 2], n - n / 2, my_adler32(&set[3], n / 2, 1)))
+    {
+      ret = TEST_ERROR;
+    }
+  }
+
+  free_words( (int32_t*)set );
+  free_words( (int32_t*)copy );
+  return ret;
+}
+
+int8_t test_crc()
+{
+  size_t n, i, offset;
+  int8_t ret = TEST_NO_ERROR;
+  uint32_t table;
+  uint32_t crc;
+  crc_impl_t best = crc_impl();
+  uint8_t check[] = "123456789";
+  uint8_t * set;
+
+  PRINTF("test_crc()\n");
+  set = (uint8_t*)reserve_words(MEM_MT_SIZE_W);
+  if (! set )
+  {
+    return TEST_ERROR;
+  }
+
+  for (i = 0; i < MEM_MT_SIZE_B; i++)
+  {
+    set[i] = (uint8_t)(i * 29 + (i >> 7));
+  }
+
+  /* Published check values, with every implementation */
+  if (crc32_update(check, 9, 0) != CRC32_CHECK)
+  {
+    ret = TEST_ERROR;
+  }
+  crc_select(CRC_IMPL_TABLE);
+  if (crc32c_update(check, 9, 0) != CRC32C_CHECK)
+  {
+    ret = TEST_ERROR;
+  }
+  if (crc_select(CRC_IMPL_HW) == CRC_IMPL_HW && crc32c_update(check, 9, 0) != CRC32C_CHECK)
+  {
+    ret = TEST_ERROR;
+  }
+
+  /* Hardware and tables agree at every alignment, and updates chain */
+  for (offset = 0; offset < 8; offset++)
+  {
+    for (n = 0; n <= MEM_MT_SIZE_B - 8; n += (n < 64) ? 1 : 4093)
+    {
+      crc_select(CRC_IMPL_TABLE);
+      table = crc32c_update(&set[offset], n, 0);
+      crc_select(CRC_IMPL_HW);
+      crc = crc32c_update(&set[offset], n, 0);
+      if (crc != table ||
+          crc != crc32c_update(&set[offset + n / 3], n - n / 3, crc32c_update(&set[offset], n / 3, 0)))
+      {
+        ret = TEST_ERROR;
+      }
+      crc = crc32_update(&set[offset], n, 0);
+      if (crc != crc32_update(&set[offset + n / 3], n - n / 3, crc32_update(&set[offset], n / 3, 0)))
+      {
+        ret = TEST_ERROR;
+      }
+    }
+  }
+
+  crc_select(best);
+  free_words( (int32_t*)set );
+  return ret;
+}
+
+int8_t test_hash()
+{
+  size_t n, i, offset, piece;
+  int8_t ret = TEST_NO_ERROR;
+  uint64_t h;
+  hash_state_t state;
+  uint8_t abc[] = "abc";
+  uint8_t spam[] = "Nobody inspects the spammish repetition";
+  uint8_t * set;
+
+  PRINTF("test_hash()\n");
+  set = (uint8_t*)reserve_words(MEM_WIDE_SIZE_W);
+  if (! set )
+  {
+    return TEST_ERROR;
+  }
+
+  for (i = 0; i < MEM_WIDE_SIZE_B; i++)
+  {
+    set[i] = (uint8_t)(i * 37 + 5);
+  }
+
+  /* Published values, one-shot and streamed */
+  if (hash64(abc, 0, 0) != HASH64_EMPTY || hash64(abc, 3, 0) != HASH64_ABC ||
+      hash64(spam, 39, 0) != HASH64_SPAM)
+  {
+    ret = TEST_ERROR;
+  }
+  hash64_init(&state, 0);
+  if (hash64_final(&state) != HASH64_EMPTY)
+  {
+    ret = TEST_ERROR;
+  }
+  hash64_update(&state, spam, 39);
+  if (hash64_final(&state) != HASH64_SPAM)
+  {
+    ret = TEST_ERROR;
+  }
+
+  /* Streaming in uneven pieces matches one call at every alignment */
+  for (offset = 0; offset < 8; offset++)
+  {
+    for (n = 0; n <= MEM_WIDE_SIZE_B - 8; n++)
+    {
+      h = hash64(&set[offset], n, n);
+      hash64_init(&state, n);
+      for (i = 0, piece = 1; i < n; i += piece, piece = piece * 3 % 41 + 1)
+      {
+        hash64_update(&state, &set[offset + i], (n - i < piece) ? n - i : piece);
+      }
+      if (hash64_final(&state) != h || (n > 0 && hash64(&set[offset], n, n + 1) == h))
+      {
+        ret = TEST_ERROR;
+      }
+    }
+  }
+
+  /* A single flipped bit changes the hash */
+  h = hash64(set, MEM_WIDE_SIZE_B, 0);
+  for (i = 0; i < MEM_WIDE_SIZE_B; i += 7)
+  {
+    set[i] ^= 0x10;
+    if (hash64(set, MEM_WIDE_SIZE_B, 0) == h)
+    {
+      ret = TEST_ERROR;
+    }
+    set[i] ^= 0x10;
+  }
+
+  free_words( (int32_t*)set );
+  return ret;
+}
+
+/* Completions seen by async_done, in the order they arrived */
+static uint8_t * volatile async_dst[DMA_QUEUE_DEPTH + 1];
+static volatile size_t async_length[DMA_QUEUE_DEPTH + 1];
+static volatile uint32_t async_calls;
+static uint8_t * volatile async_chain_src;
+static uint8_t * volatile async_chain_dst;
+static volatile uint8_t async_hold;
+
+static void async_done(uint8_t * dst, size_t length)
+{
+  if (async_calls <= DMA_QUEUE_DEPTH)
+  {
+    async_dst[async_calls] = dst;
+    async_length[async_calls] = length;
+  }
+  async_calls++;
+  /* Queue one more copy from inside a callback */
+  if (dst == async_chain_dst)
+  {
+    my_memcopy_async(async_chain_src, dst + length, 3, async_done);
+  }
+}
+
+#if defined (HOST)
+/* Holds the simulated engine until the test thread lets it go */
+static void async_block(uint8_t * dst, size_t length)
+{
+  __atomic_store_n(&async_hold, 1, __ATOMIC_SEQ_CST);
+  while (__atomic_load_n(&async_hold, __ATOMIC_SEQ_CST))
+  {
+  }
+}
+#endif
+
+int8_t test_memcopy_async()
+{
+  size_t k, i, length;
+#if defined (HOST)
+  uint32_t calls;
+#endif
+  int8_t ret = TEST_NO_ERROR;
+  uint8_t * src;
+  uint8_t * dst;
+  uint8_t * from;
+  uint8_t * to;
+
+  PRINTF("test_memcopy_async()\n");
+  src = (uint8_t*)reserve_words(MEM_MT_SIZE_W);
+  dst = (uint8_t*)reserve_words(MEM_MT_SIZE_W);
+  if (! src || ! dst )
+  {
+    free_words( (int32_t*)src );
+    free_words( (int32_t*)dst );
+    return TEST_ERROR;
+  }
+
+  for (i = 0; i < MEM_MT_SIZE_B; i++)
+  {
+    src[i] = (uint8_t)(i * 13 + (i >> 9));
+  }
+  my_memzero(dst, MEM_MT_SIZE_B);
+
+  /* Fill the queue: word, half word and byte transfers, several cycles long */
+  async_calls = 0;
+  async_chain_src = src;
+  async_chain_dst = &dst[(DMA_QUEUE_DEPTH - 1) * MEM_ASYNC_STRIDE + ((DMA_QUEUE_DEPTH - 1) * 3) % 4];
+  for (k = 0; k < DMA_QUEUE_DEPTH; k++)
+  {
+    length = k * 1100 + (k & 3);
+    from = &src[k * MEM_ASYNC_STRIDE + k];
+    to = &dst[k * MEM_ASYNC_STRIDE + (k * 3) % 4];
+    if (my_memcopy_async(from, to, length, async_done) != to)
+    {
+      ret = TEST_ERROR;
+    }
+  }
+  dma_wait();
+
+  if (dma_pending() != 0 || async_calls != DMA_QUEUE_DEPTH + 1 || dma_errors() != 0)
+  {
+    ret = TEST_ERROR;
+  }
+  for (k = 0; k < DMA_QUEUE_DEPTH; k++)
+  {
+    length = k * 1100 + (k & 3);
+    from = &src[k * MEM_ASYNC_STRIDE + k];
+    to = &dst[k * MEM_ASYNC_STRIDE + (k * 3) % 4];
+    if (async_dst[k] != to || async_length[k] != length || my_memcmp(from, to, length) != 0)
+    {
+      ret = TEST_ERROR;
+    }
+  }
+  /* The chained copy finished last, right after the copy that queued it */
+  if (async_dst[DMA_QUEUE_DEPTH] != to + length || async_length[DMA_QUEUE_DEPTH] != 3 ||
+      my_memcmp(src, to + length, 3) != 0)
+  {
+    ret = TEST_ERROR;
+  }
+
+#if defined (HOST)
+  /* With the engine held in a callback the queue fills and refuses more */
+  async_chain_dst = NULL;
+  __atomic_store_n(&async_hold, 0, __ATOMIC_SEQ_CST);
+  my_memcopy_async(src, dst, 4, async_block);
+  while (! __atomic_load_n(&async_hold, __ATOMIC_SEQ_CST) )
+  {
+  }
+  for (k = 0; k < DMA_QUEUE_DEPTH - 1; k++)
+  {
+    if (my_memcopy_async(&src[k], &dst[k * 16], 8, NULL) == NULL)
+    {
+      ret = TEST_ERROR;
+    }
+  }
+  /* A zero length copy waits its turn as well, its callback is not run here */
+  calls = async_calls;
+  if (my_memcopy_async(src, dst, 0, async_done) != dst || async_calls != calls)
+  {
+    ret = TEST_ERROR;
+  }
+  if (my_memcopy_async(src, dst, 8, NULL) != NULL || dma_pending() != DMA_QUEUE_DEPTH + 1)
+  {
+    ret = TEST_ERROR;
+  }
+  __atomic_store_n(&async_hold, 0, __ATOMIC_SEQ_CST);
+  dma_wait();
+  if (dma_pending() != 0 || async_calls != calls + 1)
+  {
+    ret = TEST_ERROR;
+  }
+#endif
+
+  free_words( (int32_t*)src );
+  free_words( (int32_t*)dst );
+  return ret;
+}
+
+int8_t test_reserve_aligned()
+{
+  size_t align, length, i;
+  int8_t ret = TEST_NO_ERROR;
+  int32_t * words;
+  uint8_t * bytes;
+
+  PRINTF("test_reserve_aligned()\n");
+
+  for (align = 1; align <= MEM_ALIGN_MAX; align <<= 1)
+  {
+    for (length = 1; length < 3 * align + 100; length += align / 2 + 37)
+    {
+      words = reserve_words_aligned(length, align);
+      bytes = reserve_bytes_aligned(length, align);
+      if (! words || ! bytes )
+      {
+        free_aligned(words);
+        free_aligned(bytes);
+        return TEST_ERROR;
+      }
+      if (((uintptr_t)words & (align - 1)) != 0 || ((uintptr_t)bytes & (align - 1)) != 0)
+      {
+        ret = TEST_ERROR;
+      }
+
+      /* Both blocks are usable end to end without touching each other */
+      for (i = 0; i < length; i++)
+      {
+        words[i] = (int32_t)(i ^ align);
+      }
+      my_memset(bytes, length, 0xA5);
+      for (i = 0; i < length; i++)
+      {
+        if (words[i] != (int32_t)(i ^ align) || bytes[i] != 0xA5)
+        {
+          ret = TEST_ERROR;
+        }
+      }
+      free_aligned(words);
+      free_aligned(bytes);
+    }
+  }
+
+  /* Alignments that are not powers of two are refused */
+  if (reserve_bytes_aligned(16, 0) != NULL || reserve_bytes_aligned(16, 48) != NULL ||
+      reserve_words_aligned(16, 3) != NULL)
+  {
+    ret = TEST_ERROR;
+  }
+  free_aligned(NULL);
+
+  return ret;
+}
+
+int8_t test_pool()
+{
+  int8_t ret = TEST_NO_ERROR;
+#if defined (POOL_AVAILABLE)
+  size_t i, j, count, size, next;
+  uint8_t * blocks[MEM_POOL_BLOCKS];
+  uint8_t * extra;
+  int32_t * heap;
+#endif
+
+  PRINTF("test_pool()\n");
+#if defined (POOL_AVAILABLE)
+  size = pool_block_size(1);
+  count = pool_available(1);
+  next = pool_available(size + 1);
+  if (size == 0 || count == 0 || count > MEM_POOL_BLOCKS)
+  {
+    return TEST_ERROR;
+  }
+
+  /* Every block of the smallest class, each distinct and aligned */
+  for (i = 0; i < count; i++)
+  {
+    blocks[i] = (uint8_t*)pool_alloc(1);
+    if (! blocks[i] || ! pool_owns(blocks[i]) || ((uintptr_t)blocks[i] & 7) != 0)
+    {
+      return TEST_ERROR;
+    }
+    my_memset(blocks[i], size, (uint8_t)i);
+  }
+  for (i = 0; i < count; i++)
+  {
+    for (j = 0; j < size; j++)
+    {
+      if (blocks[i][j] != (uint8_t)i)
+      {
+        ret = TEST_ERROR;
+      }
+    }
+  }
+  if (pool_available(1) != 0)
+  {
+    ret = TEST_ERROR;
+  }
+
+  /* A used up class spills into the next one */
+  extra = (uint8_t*)pool_alloc(1);
+  if (! extra || ! pool_owns(extra) || pool_available(size + 1) + 1 != next)
+  {
+    ret = TEST_ERROR;
+  }
+  pool_free(extra);
+
+  /* Too large for every class, and memory from elsewhere is not the pool's */
+  heap = (int32_t*)malloc(sizeof(int32_t));
+  if (pool_alloc(SIZE_MAX) != NULL || pool_block_size(SIZE_MAX) != 0 || pool_owns(heap))
+  {
+    ret = TEST_ERROR;
+  }
+  free(heap);
+
+  /* Freed blocks come back, the last one first */
+  for (i = 0; i < count; i++)
+  {
+    pool_free(blocks[i]);
+  }
+  if (pool_available(1) != count || pool_available(size + 1) != next ||
+      pool_alloc(1) != blocks[count - 1])
+  {
+    ret = TEST_ERROR;
+  }
+  pool_free(blocks[count - 1]);
+  pool_free(NULL);
+#endif
+  return ret;
+}
+
+int8_t test_arena()
+{
+  size_t i, length, align;
+  int8_t ret = TEST_NO_ERROR;
+  arena_t arena;
+  arena_mark_t mark;
+  uint8_t * region;
+  uint8_t * first;
+  uint8_t * p;
+  uint8_t * last;
+
+  PRINTF("test_arena()\n");
+  region = (uint8_t*)reserve_words(MEM_ARENA_SIZE_B / 4);
+  if (! region )
+  {
+    return TEST_ERROR;
+  }
+
+  /* Misaligned region of odd size, allocations stay inside and in order */
+  arena_init(&arena, &region[3], MEM_ARENA_SIZE_B - 8);
+  last = &region[3];
+  for (i = 0; ; i++)
+  {
+    length = (i * 37) % 200 + 1;
+    align = (size_t)1 << (i % 7);
+    p = (uint8_t*)arena_alloc(&arena, length, align);
+    if (! p )
+    {
+      break;
+    }
+    if (((uintptr_t)p & (align - 1)) != 0 || p < last || p + length > &region[MEM_ARENA_SIZE_B - 5])
+    {
+      ret = TEST_ERROR;
+    }
+    my_memset(p, length, (uint8_t)i);
+    last = p + length;
+  }
+  if (i < 20 || arena_remaining(&arena) >= 200 + 64)
+  {
+    ret = TEST_ERROR;
+  }
+
+  /* Scoped reset hands the same memory out again */
+  arena_reset_to(&arena, 0);
+  if (arena_remaining(&arena) != MEM_ARENA_SIZE_B - 8)
+  {
+    ret = TEST_ERROR;
+  }
+  first = (uint8_t*)arena_alloc(&arena, 10, 1);
+  mark = arena_mark(&arena);
+  p = (uint8_t*)arena_alloc(&arena, 100, 16);
+  arena_reset_to(&arena, mark);
+  if (first != &region[3] || arena_alloc(&arena, 100, 16) != p || arena_mark(&arena) <= mark)
+  {
+    ret = TEST_ERROR;
+  }
+
+  /* Requests that cannot fit, and bad alignments, are refused */
+  if (arena_alloc(&arena, MEM_ARENA_SIZE_B, 1) != NULL || arena_alloc(&arena, SIZE_MAX, 1) != NULL ||
+      arena_alloc(&arena, 1, 0) != NULL || arena_alloc(&arena, 1, 24) != NULL)
+  {
+    ret = TEST_ERROR;
+  }
+
+  free_words( (int32_t*)region );
+  return ret;
+}
+
+#if defined (HOST)
+/* Objects a slab test thread made, for the main thread to check and free */
+static uint8_t * slab_objects[MEM_SLAB_THREADS][MEM_SLAB_OBJECTS];
+
+static size_t slab_test_size(size_t t, size_t i)
+{
+  return (i * 131 + t * 17) % 3000 + 1;
+}
+
+/* Allocates and frees in mixed sizes, keeping every other object */
+static void * slab_worker(void * arg)
+{
+  size_t t = (size_t)arg;
+  size_t i, round;
+  uint8_t * tmp;
+
+  for (round = 0; round < 20; round++)
+  {
+    for (i = 0; i < MEM_SLAB_OBJECTS; i++)
+    {
+      tmp = (uint8_t*)slab_alloc(slab_test_size(t, i + round));
+      if (tmp)
+      {
+        my_memset(tmp, slab_test_size(t, i + round), (uint8_t)(t + round));
+      }
+      slab_free(tmp);
+    }
+  }
+  for (i = 0; i < MEM_SLAB_OBJECTS; i++)
+  {
+    slab_objects[t][i] = (uint8_t*)slab_alloc(slab_test_size(t, i));
+    if (slab_objects[t][i])
+    {
+      my_memset(slab_objects[t][i], slab_test_size(t, i), (uint8_t)(t * 31 + i));
+    }
+    if (i % 2 == 1)
+    {
+      slab_free(slab_objects[t][i - 1]);
+      slab_objects[t][i - 1] = NULL;
+    }
+  }
+  return NULL;
+}
+#endif
+
+int8_t test_slab()
+{
+  int8_t ret = TEST_NO_ERROR;
+#if defined (HOST)
+  size_t t, i, j, n, size;
+  uint8_t * p;
+  uint8_t * objs[MEM_SLAB_OBJECTS];
+  pthread_t threads[MEM_SLAB_THREADS];
+#endif
+
+  PRINTF("test_slab()\n");
+#if defined (HOST)
+
+  /* Classes are powers of two and objects are aligned to them */
+  if (slab_class_size(0) != 16 || slab_class_size(17) != 32 ||
+      slab_class_size(32768) != 32768 || slab_class_size(32769) != 0)
+  {
+    ret = TEST_ERROR;
+  }
+  for (n = 1; n < 100000; n = n * 3 / 2 + 1)
+  {
+    p = (uint8_t*)slab_alloc(n);
+    size = slab_class_size(n);
+    if (! p || ((uintptr_t)p & ((size ? size : 64) - 1)) != 0)
+    {
+      ret = TEST_ERROR;
+    }
+    else
+    {
+      my_memset(p, n, 0x5A);
+    }
+    slab_free(p);
+  }
+
+  /* Many live objects of one class do not overlap, and freed ones return */
+  for (i = 0; i < MEM_SLAB_OBJECTS; i++)
+  {
+    objs[i] = (uint8_t*)slab_alloc(48);
+    if (! objs[i] )
+    {
+      return TEST_ERROR;
+    }
+    my_memset(objs[i], 48, (uint8_t)i);
+  }
+  for (i = 0; i < MEM_SLAB_OBJECTS; i++)
+  {
+    for (j = 0; j < 48; j++)
+    {
+      if (objs[i][j] != (uint8_t)i)
+      {
+        ret = TEST_ERROR;
+      }
+    }
+  }
+  for (i = 0; i < MEM_SLAB_OBJECTS; i++)
+  {
+    slab_free(objs[i]);
+  }
+  if (slab_alloc(48) != objs[MEM_SLAB_OBJECTS - 1])
+  {
+    ret = TEST_ERROR;
+  }
+  slab_free(objs[MEM_SLAB_OBJECTS - 1]);
+  slab_free(NULL);
+
+  /* Threads at once; the objects they keep are freed here, on another thread */
+  for (t = 0; t < MEM_SLAB_THREADS; t++)
+  {
+    if (pthread_create(&threads[t], NULL, slab_worker, (void*)t) != 0)
+    {
+      return TEST_ERROR;
+    }
+  }
+  for (t = 0; t < MEM_SLAB_THREADS; t++)
+  {
+    pthread_join(threads[t], NULL);
+  }
+  for (t = 0; t < MEM_SLAB_THREADS; t++)
+  {
+    for (i = 1; i < MEM_SLAB_OBJECTS; i += 2)
+    {
+      if (! slab_objects[t][i] )
+      {
+        ret = TEST_ERROR;
+        continue;
+      }
+      for (j = 0; j < slab_test_size(t, i); j++)
+      {
+        if (slab_objects[t][i][j] != (uint8_t)(t * 31 + i))
+        {
+          ret = TEST_ERROR;
+        }
+      }
+      slab_free(slab_objects[t][i]);
+    }
+  }
+#endif
+  return ret;
+}
+
+int8_t test_tlsf()
+{
+  int8_t ret = TEST_NO_ERROR;
+#if defined (TLSF_AVAILABLE)
+  uint8_t * slots[MEM_TLSF_SLOTS];
+  size_t sizes[MEM_TLSF_SLOTS];
+  uint32_t seed = 12345;
+  int32_t before;
+  size_t i, j, s;
+  uint8_t * p;
+#endif
+
+  PRINTF("test_tlsf()\n");
+#if defined (TLSF_AVAILABLE)
+
+  /* Other tests may hold blocks when built with ALLOCATOR=tlsf */
+  before = tlsf_check();
+  if (before < 1)
+  {
+    return TEST_ERROR;
+  }
+  if (tlsf_alloc(TLSF_HEAP_SIZE + 1) != NULL || tlsf_alloc(SIZE_MAX) != NULL)
+  {
+    ret = TEST_ERROR;
+  }
+  tlsf_free(NULL);
+
+  /* Random allocations and frees; running out of heap is allowed */
+  for (s = 0; s < MEM_TLSF_SLOTS; s++)
+  {
+    slots[s] = NULL;
+    sizes[s] = 0;
+  }
+  for (i = 0; i < MEM_TLSF_OPS; i++)
+  {
+    seed = seed * 1664525u + 1013904223u;
+    s = (seed >> 8) % MEM_TLSF_SLOTS;
+    if (slots[s])
+    {
+      for (j = 0; j < sizes[s]; j++)
+      {
+        if (slots[s][j] != (uint8_t)(s * 7 + sizes[s]))
+        {
+          ret = TEST_ERROR;
+        }
+      }
+      tlsf_free(slots[s]);
+      slots[s] = NULL;
+    }
+    else
+    {
+      sizes[s] = (seed >> 20) % 512 + 1;
+      slots[s] = (uint8_t*)tlsf_alloc(sizes[s]);
+      if (slots[s])
+      {
+        if (((uintptr_t)slots[s] & 7) != 0 || ! tlsf_owns(slots[s]) ||
+            ! tlsf_owns(slots[s] + sizes[s] - 1))
+        {
+          ret = TEST_ERROR;
+        }
+        my_memset(slots[s], sizes[s], (uint8_t)(s * 7 + sizes[s]));
+      }
+    }
+    if (i % 100 == 0 && tlsf_check() < 0)
+    {
+      ret = TEST_ERROR;
+    }
+  }
+  for (s = 0; s < MEM_TLSF_SLOTS; s++)
+  {
+    tlsf_free(slots[s]);
+  }
+
+  /* Freed blocks merged back, so a large block is available again */
+  if (tlsf_check() != before)
+  {
+    ret = TEST_ERROR;
+  }
+  if (before == 1)
+  {
+    p = (uint8_t*)tlsf_alloc(TLSF_HEAP_SIZE / 2);
+    if (! p || tlsf_check() != 1)
+    {
+      ret = TEST_ERROR;
+    }
+    tlsf_free(p);
+  }
+  if (tlsf_owns(&seed))
+  {
+    ret = TEST_ERROR;
+  }
+#endif
+  return ret;
+}
+
+int8_t test_reserve_huge()
+{
+  int8_t ret = TEST_NO_ERROR;
+  mem_alloc_stats_t before, after;
+  int32_t * small;
+#if defined (HOST)
+  int32_t * big;
+  size_t length = MEM_HUGE_PAGE_SIZE / sizeof(int32_t) + 1;
+  size_t previous, i;
+  uint64_t mapped;
+#endif
+
+  PRINTF("test_reserve_huge()\n");
+
+  /* Small blocks come from the heap */
+  my_mem_alloc_stats(&before);
+  small = reserve_words(16);
+  my_mem_alloc_stats(&after);
+  if (! small || after.heap != before.heap + 1 ||
+      after.hugetlb != before.hugetlb || after.thp != before.thp)
+  {
+    ret = TEST_ERROR;
+  }
+  free_words(small);
+
+#if defined (HOST)
+  /* Above the threshold, exactly one path serves the block */
+  previous = my_mem_set_huge_threshold(MEM_HUGE_PAGE_SIZE);
+  my_mem_alloc_stats(&before);
+  big = reserve_words(length);
+  my_mem_alloc_stats(&after);
+  mapped = (after.hugetlb - before.hugetlb) + (after.thp - before.thp);
+  if (! big || mapped + (after.heap - before.heap) != 1)
+  {
+    my_mem_set_huge_threshold(previous);
+    free_words(big);
+    return TEST_ERROR;
+  }
+  if (mapped && ((uintptr_t)big & (MEM_HUGE_PAGE_SIZE - 1)) != 0)
+  {
+    ret = TEST_ERROR;
+  }
+  my_memset((uint8_t*)big, length * sizeof(int32_t), 0xA5);
+  if (big[0] != (int32_t)0xA5A5A5A5 || big[length - 1] != (int32_t)0xA5A5A5A5)
+  {
+    ret = TEST_ERROR;
+  }
+  free_words(big);
+
+  /* Freed mappings leave the registry, so this never runs out */
+  if (mapped)
+  {
+    my_mem_alloc_stats(&before);
+    for (i = 0; i < MEM_HUGE_MAPPINGS + 2; i++)
+    {
+      big = reserve_words(length);
+      if (! big )
+      {
+        ret = TEST_ERROR;
+        break;
+      }
+      big[length - 1] = (int32_t)i;
+      free_words(big);
+    }
+    my_mem_alloc_stats(&after);
+    if (after.heap != before.heap)
+    {
+      ret = TEST_ERROR;
+    }
+  }
+  my_mem_set_huge_threshold(previous);
+#endif
+  return ret;
+}
+
 void course1(void) 
 {
   uint8_t i;
@@ -338,6 +2020,28 @@ void course1(void)
   results[5] = test_memcopy();
   results[6] = test_memset();
   results[7] = test_reverse();
+  results[8] = test_memmove_unaligned();
+  results[9] = test_memset_unaligned();
+  results[10] = test_reverse_unaligned();
+  results[11] = test_memcopy_mt();
+  results[12] = test_reverse_elements();
+  results[13] = test_memfill_pattern();
+  results[14] = test_memcmp();
+  results[15] = test_memswap();
+  results[16] = test_rotate();
+  results[17] = test_memxlat();
+  results[18] = test_interleave();
+  results[19] = test_memcopyv();
+  results[20] = test_memcopy_checksum();
+  results[21] = test_crc();
+  results[22] = test_hash();
+  results[23] = test_memcopy_async();
+  results[24] = test_reserve_aligned();
+  results[25] = test_pool();
+  results[26] = test_arena();
+  results[27] = test_slab();
+  results[28] = test_tlsf();
+  results[29] = test_reserve_huge();
 
   for ( i = 0; i < TESTCOUNT; i++) 
   {
@@ -0,0 +1,345 @@
+/******************************************************************************
+ * Copyright (C) 2025 by Albert Olszewski
+ *
+ * Redistribution, modification or use of this software in source or binary
+ * forms is permitted as long as the files maintain this copyright. Users are
+ * permitted to modify this and use it to learn about the field of embedded
+ * software. Alex Fosdick and the University of Colorado are not liable for any
+ * misuse of this material.
+ *
+ *****************************************************************************/
+/**
+ * @file dma.c
+ * @brief Asynchronous copies with the DMA controller
+ *
+ * The queue and the splitting of copies into controller cycles are shared.
+ * Only starting a cycle and reporting its end differ: on MSP432 the uDMA
+ * runs an auto-request cycle on DMA_CHANNEL and raises DMA_INT1, on HOST a
+ * thread plays the controller and calls the same completion code.
+ *
+ * @author Albert Olszewski
+ * @date October 17, 2026
+ *
+ */
+#include "dma.h"
+#include <stdint.h>
+#include <stdlib.h>
+#include "memory.h"
+
+#if defined (MSP432)
+#include "msp432p401r.h"
+#else
+#include <pthread.h>
+#endif
+
+typedef struct {
+  uint8_t * src;
+  uint8_t * dst;
+  size_t length;
+  dma_callback_t callback;
+} dma_request_t;
+
+// ring of requests, the one at dma_head is on the controller
+static dma_request_t dma_queue[DMA_QUEUE_DEPTH];
+static volatile uint32_t dma_head = 0;
+static volatile uint32_t dma_count = 0;
+// copies whose callback has not returned yet
+static volatile uint32_t dma_outstanding = 0;
+// progress of the head request and size of the cycle running
+static volatile size_t dma_done = 0;
+static volatile size_t dma_chunk = 0;
+static volatile uint32_t dma_error_count = 0;
+
+static void dma_hw_start(uint8_t * src, uint8_t * dst, size_t items, uint32_t width);
+
+/***********************************************************
+ Request Queue
+***********************************************************/
+// log2 of the widest transfer both pointers allow with data left for it
+static uint32_t dma_width(uint8_t * src, uint8_t * dst, size_t remaining) {
+  uintptr_t a = (uintptr_t)src | (uintptr_t)dst;
+
+  if ((a & 3) == 0 && remaining >= 4) {
+    return 2;
+  }
+  if ((a & 1) == 0 && remaining >= 2) {
+    return 1;
+  }
+  return 0;
+}
+
+// the caller holds the lock or is the interrupt; a zero length request
+// gets a cycle of no items, which completes at once
+static void dma_start_cycle(void) {
+  dma_request_t * req = &dma_queue[dma_head];
+  uint8_t * src = req->src + dma_done;
+  uint8_t * dst = req->dst + dma_done;
+  uint32_t width = dma_width(src, dst, req->length - dma_done);
+  size_t items = (req->length - dma_done) >> width;
+
+  if (items > DMA_MAX_TRANSFERS) {
+    items = DMA_MAX_TRANSFERS;
+  }
+  dma_chunk = items << width;
+  dma_hw_start(src, dst, items, width);
+}
+
+// end of a cycle: start the next one, and return 1 with the request in
+// *finished when it was the last of that request
+static uint8_t dma_cycle_done(uint8_t failed, dma_request_t * finished, size_t * copied) {
+  dma_request_t * req = &dma_queue[dma_head];
+
+  if (!failed) {
+    dma_done += dma_chunk;
+    if (dma_done < req->length) {
+      dma_start_cycle();
+      return 0;
+    }
+  }
+  *finished = *req;
+  *copied = dma_done;
+  dma_done = 0;
+  dma_head = (dma_head + 1) % DMA_QUEUE_DEPTH;
+  dma_count--;
+  if (dma_count > 0) {
+    dma_start_cycle();
+  }
+  return 1;
+}
+
+#if defined (MSP432)
+/***********************************************************
+ uDMA Controller (MSP432)
+***********************************************************/
+// channel control structure, see the uDMA chapter of the reference manual
+typedef struct {
+  void * volatile src_end;
+  void * volatile dst_end;
+  volatile uint32_t control;
+  uint32_t spare;
+} dma_control_t;
+
+#define DMA_CTL_DST_INC(w)  ((uint32_t)(w) << 30)
+#define DMA_CTL_DST_SIZE(w) ((uint32_t)(w) << 28)
+#define DMA_CTL_SRC_INC(w)  ((uint32_t)(w) << 26)
+#define DMA_CTL_SRC_SIZE(w) ((uint32_t)(w) << 24)
+#define DMA_CTL_ARB(r)      ((uint32_t)(r) << 14)
+#define DMA_CTL_N(n)        ((uint32_t)((n) - 1) << 4)
+#define DMA_CTL_MODE_AUTO   (0x2u)
+
+// re-arbitrate every 2^4 transfers so other channels are not held off
+#define DMA_ARB_POWER (4)
+
+// 8 primary then 8 alternate structures, the table is aligned to its size
+static dma_control_t dma_table[16] __attribute__((aligned(256)));
+static uint8_t dma_ready = 0;
+
+static uint32_t dma_lock(void) {
+  uint32_t primask = __get_PRIMASK();
+
+  __disable_irq();
+  return primask;
+}
+
+static void dma_unlock(uint32_t primask) {
+  __set_PRIMASK(primask);
+}
+
+static int8_t dma_engine_init(void) {
+  if (!dma_ready) {
+    DMA_Control->CFG = DMA_CFG_MASTEN;
+    DMA_Control->CTLBASE = (uint32_t)(uintptr_t)dma_table;
+    // source 0 of each channel is the software request
+    DMA_Channel->CH_SRCCFG[DMA_CHANNEL] = 0;
+    DMA_Channel->INT1_SRCCFG = DMA_INT1_SRCCFG_EN | DMA_CHANNEL;
+    NVIC_EnableIRQ(DMA_INT1_IRQn);
+    NVIC_EnableIRQ(DMA_ERR_IRQn);
+    dma_ready = 1;
+  }
+  return 0;
+}
+
+static void dma_hw_start(uint8_t * src, uint8_t * dst, size_t items, uint32_t width) {
+  dma_control_t * ctl = &dma_table[DMA_CHANNEL];
+
+  // a zero length copy has no cycle to run, only its completion
+  if (items == 0) {
+    NVIC_SetPendingIRQ(DMA_INT1_IRQn);
+    return;
+  }
+  // the controller takes the address of the last transfer, not the first
+  ctl->src_end = src + ((items - 1) << width);
+  ctl->dst_end = dst + ((items - 1) << width);
+  ctl->control = DMA_CTL_DST_INC(width) | DMA_CTL_DST_SIZE(width) |
+                 DMA_CTL_SRC_INC(width) | DMA_CTL_SRC_SIZE(width) |
+                 DMA_CTL_ARB(DMA_ARB_POWER) | DMA_CTL_N(items) | DMA_CTL_MODE_AUTO;
+  DMA_Control->ENASET = 1u << DMA_CHANNEL;
+  DMA_Channel->SW_CHTRIG = 1u << DMA_CHANNEL;
+}
+
+static void dma_interrupt(uint8_t failed) {
+  dma_request_t req;
+  size_t copied;
+
+  if (dma_cycle_done(failed, &req, &copied)) {
+    if (req.callback != NULL) {
+      req.callback(req.dst, copied);
+    }
+    dma_outstanding--;
+  }
+}
+
+void DMA_INT1_IRQHandler(void) {
+  dma_interrupt(0);
+}
+
+void DMA_ERR_IRQHandler(void) {
+  DMA_Control->ERRCLR = DMA_ERRCLR_ERRCLR;
+  DMA_Control->ENACLR = 1u << DMA_CHANNEL;
+  dma_error_count++;
+  dma_interrupt(1);
+}
+
+void dma_wait(void) {
+  // interrupts stay off between the check and the sleep, so a completion
+  // in between still wakes the core
+  for (;;) {
+    __disable_irq();
+    if (dma_outstanding == 0) {
+      __enable_irq();
+      return;
+    }
+    __WFI();
+    __enable_irq();
+  }
+}
+
+#else
+/***********************************************************
+ Simulated Controller (HOST)
+***********************************************************/
+static pthread_mutex_t dma_mutex = PTHREAD_MUTEX_INITIALIZER;
+static pthread_cond_t dma_start_cond = PTHREAD_COND_INITIALIZER;
+static pthread_cond_t dma_idle_cond = PTHREAD_COND_INITIALIZER;
+static uint8_t dma_ready = 0;
+
+// the cycle programmed into the simulated controller
+static uint8_t * dma_sim_src;
+static uint8_t * dma_sim_dst;
+static size_t dma_sim_bytes;
+static uint8_t dma_sim_armed = 0;
+
+static uint32_t dma_lock(void) {
+  pthread_mutex_lock(&dma_mutex);
+  return 0;
+}
+
+static void dma_unlock(uint32_t key) {
+  (void)key;
+  pthread_mutex_unlock(&dma_mutex);
+}
+
+static void dma_hw_start(uint8_t * src, uint8_t * dst, size_t items, uint32_t width) {
+  dma_sim_src = src;
+  dma_sim_dst = dst;
+  dma_sim_bytes = items << width;
+  dma_sim_armed = 1;
+  pthread_cond_signal(&dma_start_cond);
+}
+
+// plays the controller: one cycle per wakeup, then the "interrupt"
+static void * dma_engine(void * arg) {
+  dma_request_t req;
+  size_t copied;
+  uint8_t * src;
+  uint8_t * dst;
+  size_t bytes;
+
+  (void)arg;
+  pthread_mutex_lock(&dma_mutex);
+  for (;;) {
+    while (!dma_sim_armed) {
+      pthread_cond_wait(&dma_start_cond, &dma_mutex);
+    }
+    src = dma_sim_src;
+    dst = dma_sim_dst;
+    bytes = dma_sim_bytes;
+
+    // the data moves while the core keeps running
+    pthread_mutex_unlock(&dma_mutex);
+    my_memcopy(src, dst, bytes);
+    pthread_mutex_lock(&dma_mutex);
+
+    dma_sim_armed = 0;
+    if (dma_cycle_done(0, &req, &copied)) {
+      // unlocked so the callback can queue the next copy
+      if (req.callback != NULL) {
+        pthread_mutex_unlock(&dma_mutex);
+        req.callback(req.dst, copied);
+        pthread_mutex_lock(&dma_mutex);
+      }
+      dma_outstanding--;
+      if (dma_outstanding == 0) {
+        pthread_cond_broadcast(&dma_idle_cond);
+      }
+    }
+  }
+  return NULL;
+}
+
+// the caller holds the lock
+static int8_t dma_engine_init(void) {
+  pthread_t thread;
+
+  if (!dma_ready) {
+    if (pthread_create(&thread, NULL, dma_engine, NULL) != 0) {
+      return -1;
+    }
+    pthread_detach(thread);
+    dma_ready = 1;
+  }
+  return 0;
+}
+
+void dma_wait(void) {
+  pthread_mutex_lock(&dma_mutex);
+  while (dma_outstanding > 0) {
+    pthread_cond_wait(&dma_idle_cond, &dma_mutex);
+  }
+  pthread_mutex_unlock(&dma_mutex);
+}
+#endif /* MSP432 */
+
+/***********************************************************
+ Function Definitions
+***********************************************************/
+uint8_t * my_memcopy_async(uint8_t * src, uint8_t * dst, size_t length, dma_callback_t callback) {
+  dma_request_t * req;
+  uint32_t key;
+
+  key = dma_lock();
+  if (dma_engine_init() != 0 || dma_count == DMA_QUEUE_DEPTH) {
+    dma_unlock(key);
+    return NULL;
+  }
+  req = &dma_queue[(dma_head + dma_count) % DMA_QUEUE_DEPTH];
+  req->src = src;
+  req->dst = dst;
+  req->length = length;
+  req->callback = callback;
+  dma_count++;
+  dma_outstanding++;
+  if (dma_count == 1) {
+    dma_start_cycle();
+  }
+  dma_unlock(key);
+  return dst;
+}
+
+uint32_t dma_pending(void) {
+  return dma_outstanding;
+}
+
+uint32_t dma_errors(void) {
+  return dma_error_count;
+}
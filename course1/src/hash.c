@@ -0,0 +1,185 @@
+/******************************************************************************
+ * Copyright (C) 2025 by Albert Olszewski
+ *
+ * Redistribution, modification or use of this software in source or binary
+ * forms is permitted as long as the files maintain this copyright. Users are
+ * permitted to modify this and use it to learn about the field of embedded
+ * software. Alex Fosdick and the University of Colorado are not liable for any
+ * misuse of this material.
+ *
+ *****************************************************************************/
+/**
+ * @file hash.c
+ * @brief Non-cryptographic 64-bit hash of data buffers
+ *
+ * XXH64. Only 64-bit adds, multiplies and rotates are used, which the
+ * Cortex-M4 does through libgcc, so HOST and MSP432 agree bit for bit.
+ *
+ * @author Albert Olszewski
+ * @date October 17, 2026
+ *
+ */
+#include "hash.h"
+#include <stdint.h>
+#include <stdlib.h>
+
+#define PRIME1 (0x9E3779B185EBCA87ull)
+#define PRIME2 (0xC2B2AE3D27D4EB4Full)
+#define PRIME3 (0x165667B19E3779F9ull)
+#define PRIME4 (0x85EBCA77C2B2AE63ull)
+#define PRIME5 (0x27D4EB2F165667C5ull)
+
+// words that may sit at any address, both targets are little endian
+typedef uint32_t __attribute__((__may_alias__, __aligned__(1))) hash_u32_t;
+typedef uint64_t __attribute__((__may_alias__, __aligned__(1))) hash_u64_t;
+
+#define LOAD32(p) (*(hash_u32_t *)(p))
+#define LOAD64(p) (*(hash_u64_t *)(p))
+
+/***********************************************************
+ Lane Arithmetic
+***********************************************************/
+static inline uint64_t rotl64(uint64_t x, int r) {
+  return (x << r) | (x >> (64 - r));
+}
+
+static inline uint64_t hash_round(uint64_t acc, uint64_t input) {
+  acc += input * PRIME2;
+  acc = rotl64(acc, 31);
+  return acc * PRIME1;
+}
+
+static inline uint64_t hash_merge(uint64_t h, uint64_t lane) {
+  h ^= hash_round(0, lane);
+  return h * PRIME1 + PRIME4;
+}
+
+// whole stripes only, the four lanes have no dependency on each other
+static uint8_t * hash_stripes(uint64_t lanes[4], uint8_t * src, size_t length) {
+  uint64_t v1 = lanes[0];
+  uint64_t v2 = lanes[1];
+  uint64_t v3 = lanes[2];
+  uint64_t v4 = lanes[3];
+
+  while (length >= HASH_STRIPE) {
+    v1 = hash_round(v1, LOAD64(src));
+    v2 = hash_round(v2, LOAD64(src + 8));
+    v3 = hash_round(v3, LOAD64(src + 16));
+    v4 = hash_round(v4, LOAD64(src + 24));
+    src += HASH_STRIPE;
+    length -= HASH_STRIPE;
+  }
+  lanes[0] = v1;
+  lanes[1] = v2;
+  lanes[2] = v3;
+  lanes[3] = v4;
+  return src;
+}
+
+// folds the lanes, the total length and the last partial stripe together
+static uint64_t hash_finish(const uint64_t lanes[4], uint64_t total, uint64_t seed,
+                            uint8_t * tail, size_t length) {
+  uint64_t h;
+
+  if (total >= HASH_STRIPE) {
+    h = rotl64(lanes[0], 1) + rotl64(lanes[1], 7) + rotl64(lanes[2], 12) + rotl64(lanes[3], 18);
+    h = hash_merge(h, lanes[0]);
+    h = hash_merge(h, lanes[1]);
+    h = hash_merge(h, lanes[2]);
+    h = hash_merge(h, lanes[3]);
+  } else {
+    h = seed + PRIME5;
+  }
+  h += total;
+
+  while (length >= 8) {
+    h ^= hash_round(0, LOAD64(tail));
+    h = rotl64(h, 27) * PRIME1 + PRIME4;
+    tail += 8;
+    length -= 8;
+  }
+  if (length >= 4) {
+    h ^= (uint64_t)LOAD32(tail) * PRIME1;
+    h = rotl64(h, 23) * PRIME2 + PRIME3;
+    tail += 4;
+    length -= 4;
+  }
+  while (length > 0) {
+    h ^= (uint64_t)(*tail++) * PRIME5;
+    h = rotl64(h, 11) * PRIME1;
+    length--;
+  }
+
+  // avalanche so every input bit affects every output bit
+  h ^= h >> 33;
+  h *= PRIME2;
+  h ^= h >> 29;
+  h *= PRIME3;
+  h ^= h >> 32;
+  return h;
+}
+
+static void hash_lanes_init(uint64_t lanes[4], uint64_t seed) {
+  lanes[0] = seed + PRIME1 + PRIME2;
+  lanes[1] = seed + PRIME2;
+  lanes[2] = seed;
+  lanes[3] = seed - PRIME1;
+}
+
+/***********************************************************
+ Function Definitions
+***********************************************************/
+uint64_t hash64(uint8_t * src, size_t length, uint64_t seed) {
+  uint64_t lanes[4];
+  uint8_t * tail;
+
+  hash_lanes_init(lanes, seed);
+  tail = hash_stripes(lanes, src, length);
+  return hash_finish(lanes, length, seed, tail, length - (size_t)(tail - src));
+}
+
+void hash64_init(hash_state_t * state, uint64_t seed) {
+  hash_lanes_init(state->lanes, seed);
+  state->total = 0;
+  state->seed = seed;
+  state->buffered = 0;
+}
+
+void hash64_update(hash_state_t * state, uint8_t * src, size_t length) {
+  size_t fill;
+  size_t i;
+
+  state->total += length;
+
+  // top up a partial stripe left by the previous call first
+  if (state->buffered > 0) {
+    fill = HASH_STRIPE - state->buffered;
+    if (length < fill) {
+      fill = length;
+    }
+    for (i = 0; i < fill; i++) {
+      state->buffer[state->buffered + i] = src[i];
+    }
+    state->buffered += fill;
+    src += fill;
+    length -= fill;
+    if (state->buffered < HASH_STRIPE) {
+      return;
+    }
+    hash_stripes(state->lanes, state->buffer, HASH_STRIPE);
+    state->buffered = 0;
+  }
+
+  // stripes straight from the caller's buffer, keep what is left over
+  fill = length - (size_t)(hash_stripes(state->lanes, src, length) - src);
+  src += length - fill;
+  for (i = 0; i < fill; i++) {
+    state->buffer[i] = src[i];
+  }
+  state->buffered = fill;
+}
+
+uint64_t hash64_final(const hash_state_t * state) {
+  return hash_finish(state->lanes, state->total, state->seed,
+                     (uint8_t *)state->buffer, state->buffered);
+}
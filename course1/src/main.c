@@ -14,16 +14,23 @@
  *
  * This file contains the main code for the final assessment.  The main function is simple.
  * Output can be specified by the -DCOURSE1 flag during compile time. 
+ * Benchmarks are run after it with the -DBENCH flag.
  *
  * @author Albert Olszewski
  * @date June 24, 2025
  *
  */
 #include "course1.h"
+#ifdef BENCH
+#include "bench.h"
+#endif
 
 int main(void) {
 #ifdef COURSE1
 	course1();
+#endif
+#ifdef BENCH
+	bench();
 #endif
 	return 0;
 
@@ -20,10 +20,48 @@
  * @date April 1 2017
  *
  */
+// posix_memalign is POSIX, MAP_HUGETLB and MADV_HUGEPAGE are Linux, none
+// of them C99
+#if defined (HOST)
+#define _GNU_SOURCE
+#endif
+
 #include "memory.h"
+#include "crc.h"
+#if defined (MEM_ALLOC_POOL)
+#include "pool.h"
+#elif defined (MEM_ALLOC_SLAB)
+#include "slab.h"
+#elif defined (MEM_ALLOC_TLSF)
+#include "tlsf.h"
+#endif
+#include <stddef.h>
 #include <stdint.h>
 #include <stdlib.h>
 
+// vector kernels are only built for x86 hosts, everything else stays scalar
+#if defined (HOST) && (defined (__x86_64__) || defined (__i386__))
+#define MEM_X86
+#include <immintrin.h>
+#endif
+
+// device header pulls in cmsis_gcc.h for __REV and friends
+#if defined (MSP432)
+#include "msp432p401r.h"
+#include <errno.h>
+#endif
+
+// worker threads for the parallel variants
+#if defined (HOST)
+#include <pthread.h>
+#include <sys/mman.h>
+#endif
+
+// huge page mappings need both flags, which only Linux has
+#if defined (HOST) && defined (MAP_HUGETLB) && defined (MADV_HUGEPAGE)
+#define MEM_HUGE
+#endif
+
 /***********************************************************
  Function Definitions
 ***********************************************************/
@@ -46,10 +84,1442 @@ void set_all(char * ptr, char value, unsigned int size){
   }
 }
 
-void clear_all(char * ptr, unsigned int size){
-  set_all(ptr, 0, size);
+void clear_all(char * ptr, unsigned int size){
+  set_all(ptr, 0, size);
+}
+
+
+/***********************************************************
+ Word Copy Engine
+***********************************************************/
+// native word width used for the bulk of a copy
+#if defined (MSP432)
+typedef uint32_t mem_word_t;
+#else
+typedef uint64_t mem_word_t;
+#endif
+
+// same word, but allowed to sit at any address and alias any type
+typedef mem_word_t __attribute__((__may_alias__, __aligned__(1))) mem_uword_t;
+
+#define MEM_WORD_SIZE (sizeof(mem_word_t))
+#define MEM_WORD_MASK ((uintptr_t)(MEM_WORD_SIZE - 1))
+
+#if defined (MSP432)
+// one LDM/STM burst moves 8 registers, r7 is left alone as the thumb frame pointer
+#define MEM_BURST_SIZE (32)
+#define MEM_BURST_REGS "{r3-r6, r8-r10, r12}"
+#endif
+
+static void copy_forward(uint8_t * src, uint8_t * dst, size_t length) {
+  // copy bytes until the destination is word aligned
+  while (length > 0 && ((uintptr_t)dst & MEM_WORD_MASK) != 0) {
+    *dst++ = *src++;
+    length--;
+  }
+#if defined (MSP432)
+  // LDM/STM need both pointers word aligned, bursts of 8 words at a time
+  if (((uintptr_t)src & MEM_WORD_MASK) == 0 && length >= MEM_BURST_SIZE) {
+    size_t bursts = length / MEM_BURST_SIZE;
+
+    length -= bursts * MEM_BURST_SIZE;
+    __asm__ volatile (
+      "1:                                    \n"
+      "  ldmia %[s]!, " MEM_BURST_REGS "     \n"
+      "  stmia %[d]!, " MEM_BURST_REGS "     \n"
+      "  subs  %[n], %[n], #1                \n"
+      "  bne   1b                            \n"
+      : [s] "+r" (src), [d] "+r" (dst), [n] "+r" (bursts)
+      :
+      : "r3", "r4", "r5", "r6", "r8", "r9", "r10", "r12", "cc", "memory");
+  }
+#endif
+  // copy whole words, the source may still be unaligned
+  while (length >= MEM_WORD_SIZE) {
+    *(mem_uword_t *)dst = *(mem_uword_t *)src;
+    dst += MEM_WORD_SIZE;
+    src += MEM_WORD_SIZE;
+    length -= MEM_WORD_SIZE;
+  }
+  // finish the tail one byte at a time
+  while (length > 0) {
+    *dst++ = *src++;
+    length--;
+  }
+}
+
+static void copy_backward(uint8_t * src, uint8_t * dst, size_t length) {
+  // work down from the end of both regions
+  src += length;
+  dst += length;
+  // copy bytes until the end of the destination is word aligned
+  while (length > 0 && ((uintptr_t)dst & MEM_WORD_MASK) != 0) {
+    *--dst = *--src;
+    length--;
+  }
+#if defined (MSP432)
+  // same bursts working down, each burst is read before it is written
+  if (((uintptr_t)src & MEM_WORD_MASK) == 0 && length >= MEM_BURST_SIZE) {
+    size_t bursts = length / MEM_BURST_SIZE;
+
+    length -= bursts * MEM_BURST_SIZE;
+    __asm__ volatile (
+      "1:                                    \n"
+      "  ldmdb %[s]!, " MEM_BURST_REGS "     \n"
+      "  stmdb %[d]!, " MEM_BURST_REGS "     \n"
+      "  subs  %[n], %[n], #1                \n"
+      "  bne   1b                            \n"
+      : [s] "+r" (src), [d] "+r" (dst), [n] "+r" (bursts)
+      :
+      : "r3", "r4", "r5", "r6", "r8", "r9", "r10", "r12", "cc", "memory");
+  }
+#endif
+  // copy whole words, each word is read before it is written
+  while (length >= MEM_WORD_SIZE) {
+    dst -= MEM_WORD_SIZE;
+    src -= MEM_WORD_SIZE;
+    *(mem_uword_t *)dst = *(mem_uword_t *)src;
+    length -= MEM_WORD_SIZE;
+  }
+  // finish the head one byte at a time
+  while (length > 0) {
+    *--dst = *--src;
+    length--;
+  }
+}
+
+static void set_forward(uint8_t * dst, size_t length, uint8_t value) {
+  // replicate the value into every byte of a word
+  mem_word_t pattern = (mem_word_t)value * ((mem_word_t)~(mem_word_t)0 / 0xFF);
+
+  while (length > 0 && ((uintptr_t)dst & MEM_WORD_MASK) != 0) {
+    *dst++ = value;
+    length--;
+  }
+  while (length >= MEM_WORD_SIZE) {
+    *(mem_uword_t *)dst = pattern;
+    dst += MEM_WORD_SIZE;
+    length -= MEM_WORD_SIZE;
+  }
+  while (length > 0) {
+    *dst++ = value;
+    length--;
+  }
+}
+
+/***********************************************************
+ Small Size Kernels
+***********************************************************/
+// fixed width accessors that may sit at any address
+typedef uint16_t __attribute__((__may_alias__, __aligned__(1))) mem_u16_t;
+typedef uint32_t __attribute__((__may_alias__, __aligned__(1))) mem_u32_t;
+typedef uint64_t __attribute__((__may_alias__, __aligned__(1))) mem_u64_t;
+
+#define LOAD16(p)     (*(mem_u16_t *)(p))
+#define LOAD32(p)     (*(mem_u32_t *)(p))
+#define LOAD64(p)     (*(mem_u64_t *)(p))
+#define STORE16(p, v) (*(mem_u16_t *)(p) = (v))
+#define STORE32(p, v) (*(mem_u32_t *)(p) = (v))
+#define STORE64(p, v) (*(mem_u64_t *)(p) = (v))
+
+// each size class is covered by a head and a tail access that may overlap
+static void copy_small(uint8_t * src, uint8_t * dst, size_t length) {
+  uint64_t a, b, c, d, e, f, g, h;
+
+  // every load happens before any store, so overlapping moves are safe too
+  if (length >= 32) {
+    a = LOAD64(src);
+    b = LOAD64(src + 8);
+    c = LOAD64(src + 16);
+    d = LOAD64(src + 24);
+    e = LOAD64(src + length - 32);
+    f = LOAD64(src + length - 24);
+    g = LOAD64(src + length - 16);
+    h = LOAD64(src + length - 8);
+    STORE64(dst, a);
+    STORE64(dst + 8, b);
+    STORE64(dst + 16, c);
+    STORE64(dst + 24, d);
+    STORE64(dst + length - 32, e);
+    STORE64(dst + length - 24, f);
+    STORE64(dst + length - 16, g);
+    STORE64(dst + length - 8, h);
+  } else if (length >= 16) {
+    a = LOAD64(src);
+    b = LOAD64(src + 8);
+    c = LOAD64(src + length - 16);
+    d = LOAD64(src + length - 8);
+    STORE64(dst, a);
+    STORE64(dst + 8, b);
+    STORE64(dst + length - 16, c);
+    STORE64(dst + length - 8, d);
+  } else if (length >= 8) {
+    a = LOAD64(src);
+    b = LOAD64(src + length - 8);
+    STORE64(dst, a);
+    STORE64(dst + length - 8, b);
+  } else if (length >= 4) {
+    uint32_t x = LOAD32(src);
+    uint32_t y = LOAD32(src + length - 4);
+    STORE32(dst, x);
+    STORE32(dst + length - 4, y);
+  } else if (length >= 2) {
+    uint16_t x = LOAD16(src);
+    uint16_t y = LOAD16(src + length - 2);
+    STORE16(dst, x);
+    STORE16(dst + length - 2, y);
+  } else if (length == 1) {
+    *dst = *src;
+  }
+}
+
+static void set_small(uint8_t * dst, size_t length, uint8_t value) {
+  uint64_t v = (uint64_t)value * 0x0101010101010101ull;
+
+  if (length >= 32) {
+    STORE64(dst, v);
+    STORE64(dst + 8, v);
+    STORE64(dst + 16, v);
+    STORE64(dst + 24, v);
+    STORE64(dst + length - 32, v);
+    STORE64(dst + length - 24, v);
+    STORE64(dst + length - 16, v);
+    STORE64(dst + length - 8, v);
+  } else if (length >= 16) {
+    STORE64(dst, v);
+    STORE64(dst + 8, v);
+    STORE64(dst + length - 16, v);
+    STORE64(dst + length - 8, v);
+  } else if (length >= 8) {
+    STORE64(dst, v);
+    STORE64(dst + length - 8, v);
+  } else if (length >= 4) {
+    STORE32(dst, (uint32_t)v);
+    STORE32(dst + length - 4, (uint32_t)v);
+  } else if (length >= 2) {
+    STORE16(dst, (uint16_t)v);
+    STORE16(dst + length - 2, (uint16_t)v);
+  } else if (length == 1) {
+    *dst = value;
+  }
+}
+
+/***********************************************************
+ Pattern Fill Kernels
+***********************************************************/
+// an 8 byte pattern lives in a uint64_t in memory order, both targets are
+// little endian so byte k of the pattern is bits 8k..8k+7
+
+// the pattern as seen from a byte offset into the fill
+static uint64_t pattern_phase(uint64_t pattern, size_t offset) {
+  unsigned int shift = (unsigned int)(offset & 7) * 8;
+
+  return (shift == 0) ? pattern : (pattern >> shift) | (pattern << (64 - shift));
+}
+
+static void fill_forward(uint8_t * dst, size_t length, uint64_t pattern) {
+  uint8_t * start = dst;
+  uint64_t word;
+
+  while (length > 0 && ((uintptr_t)dst & 7) != 0) {
+    *dst = (uint8_t)pattern_phase(pattern, (size_t)(dst - start));
+    dst++;
+    length--;
+  }
+  // aligned stores of the pattern rotated to the current phase
+  word = pattern_phase(pattern, (size_t)(dst - start));
+  while (length >= 8) {
+    *(mem_u64_t *)dst = word;
+    dst += 8;
+    length -= 8;
+  }
+  while (length > 0) {
+    *dst = (uint8_t)pattern_phase(pattern, (size_t)(dst - start));
+    dst++;
+    length--;
+  }
+}
+
+/***********************************************************
+ Reverse Kernels
+***********************************************************/
+#if defined (MSP432)
+#define MEM_WORD_BSWAP(x) __REV(x)
+#else
+#define MEM_WORD_BSWAP(x) __builtin_bswap64(x)
+#endif
+
+static void reverse_words(uint8_t * src, size_t length) {
+  uint8_t * lo = src;
+  uint8_t * hi = src + length;
+  mem_word_t a, b;
+  uint8_t temp;
+
+#if defined (MSP432)
+  // 16 bytes from each end per step, REV the words and swap their order
+  while (hi - lo >= 32) {
+    uint32_t a0 = LOAD32(lo), a1 = LOAD32(lo + 4), a2 = LOAD32(lo + 8), a3 = LOAD32(lo + 12);
+    uint32_t b0 = LOAD32(hi - 16), b1 = LOAD32(hi - 12), b2 = LOAD32(hi - 8), b3 = LOAD32(hi - 4);
+    STORE32(lo, __REV(b3));
+    STORE32(lo + 4, __REV(b2));
+    STORE32(lo + 8, __REV(b1));
+    STORE32(lo + 12, __REV(b0));
+    STORE32(hi - 16, __REV(a3));
+    STORE32(hi - 12, __REV(a2));
+    STORE32(hi - 8, __REV(a1));
+    STORE32(hi - 4, __REV(a0));
+    lo += 16;
+    hi -= 16;
+  }
+#endif
+  // one word from each end, byte swapped into the opposite end
+  while (hi - lo >= (ptrdiff_t)(2 * MEM_WORD_SIZE)) {
+    a = *(mem_uword_t *)lo;
+    b = *(mem_uword_t *)(hi - MEM_WORD_SIZE);
+    *(mem_uword_t *)lo = MEM_WORD_BSWAP(b);
+    *(mem_uword_t *)(hi - MEM_WORD_SIZE) = MEM_WORD_BSWAP(a);
+    lo += MEM_WORD_SIZE;
+    hi -= MEM_WORD_SIZE;
+  }
+  // swap the remaining middle bytes
+  while (hi - lo >= 2) {
+    hi--;
+    temp = *lo;
+    *lo = *hi;
+    *hi = temp;
+    lo++;
+  }
+}
+
+#if defined (MSP432)
+#define MEM_BSWAP32(x) __REV(x)
+#else
+#define MEM_BSWAP32(x) __builtin_bswap32(x)
+#endif
+
+// width is the element size in bytes: 2, 4 or 8
+static void reverse_elems(uint8_t * src, size_t count, size_t width) {
+  uint8_t * lo = src;
+  uint8_t * hi = src + count * width;
+
+  // one element from each end per step, swapped whole
+  while (hi - lo >= (ptrdiff_t)(2 * width)) {
+    hi -= width;
+    if (width == 2) {
+      uint16_t a = LOAD16(lo);
+      STORE16(lo, LOAD16(hi));
+      STORE16(hi, a);
+    } else if (width == 4) {
+      uint32_t a = LOAD32(lo);
+      STORE32(lo, LOAD32(hi));
+      STORE32(hi, a);
+    } else {
+      uint64_t a = LOAD64(lo);
+      STORE64(lo, LOAD64(hi));
+      STORE64(hi, a);
+    }
+    lo += width;
+  }
+}
+
+static void bswap_elems(uint8_t * src, size_t count, size_t width) {
+  uint8_t * end = src + count * width;
+
+  if (width == 2) {
+#if defined (MSP432)
+    // two samples per REV16
+    while (end - src >= 4) {
+      STORE32(src, __REV16(LOAD32(src)));
+      src += 4;
+    }
+#endif
+    for (; src < end; src += 2) {
+      STORE16(src, __builtin_bswap16(LOAD16(src)));
+    }
+  } else if (width == 4) {
+    for (; src < end; src += 4) {
+      STORE32(src, MEM_BSWAP32(LOAD32(src)));
+    }
+  } else {
+    // swap the two halves as well as the bytes within them
+    for (; src < end; src += 8) {
+      uint32_t lo = LOAD32(src);
+      uint32_t hi = LOAD32(src + 4);
+      STORE32(src, MEM_BSWAP32(hi));
+      STORE32(src + 4, MEM_BSWAP32(lo));
+    }
+  }
+}
+
+/***********************************************************
+ Swap Kernels
+***********************************************************/
+static void swap_words(uint8_t * a, uint8_t * b, size_t length) {
+  mem_word_t x, y;
+  uint8_t temp;
+
+  // both sides are read into registers before either is written
+  while (length >= MEM_WORD_SIZE) {
+    x = *(mem_uword_t *)a;
+    y = *(mem_uword_t *)b;
+    *(mem_uword_t *)a = y;
+    *(mem_uword_t *)b = x;
+    a += MEM_WORD_SIZE;
+    b += MEM_WORD_SIZE;
+    length -= MEM_WORD_SIZE;
+  }
+  while (length > 0) {
+    temp = *a;
+    *a++ = *b;
+    *b++ = temp;
+    length--;
+  }
+}
+
+/***********************************************************
+ Translate Kernels
+***********************************************************/
+#define XLAT_WORD(w, table) ((uint32_t)(table)[(w) & 0xFF] | \
+                             (uint32_t)(table)[((w) >> 8) & 0xFF] << 8 | \
+                             (uint32_t)(table)[((w) >> 16) & 0xFF] << 16 | \
+                             (uint32_t)(table)[(w) >> 24] << 24)
+
+// unrolled table walk, 8 bytes per step, each word is loaded before it is
+// stored so src == dst works
+static void xlat_words(uint8_t * src, uint8_t * dst, size_t length, uint8_t * table) {
+  uint32_t a, b;
+
+  while (length >= 8) {
+    a = LOAD32(src);
+    b = LOAD32(src + 4);
+    STORE32(dst, XLAT_WORD(a, table));
+    STORE32(dst + 4, XLAT_WORD(b, table));
+    src += 8;
+    dst += 8;
+    length -= 8;
+  }
+  while (length > 0) {
+    *dst++ = table[*src++];
+    length--;
+  }
+}
+
+/***********************************************************
+ Compare and Search Kernels
+***********************************************************/
+#if defined (MSP432)
+#define MEM_WORD_CTZ(x) ((size_t)__builtin_ctz(x))
+#define MEM_WORD_CLZ(x) ((size_t)__CLZ(x))
+#else
+#define MEM_WORD_CTZ(x) ((size_t)__builtin_ctzll(x))
+#define MEM_WORD_CLZ(x) ((size_t)__builtin_clzll(x))
+#endif
+
+#define MEM_WORD_ONES  ((mem_word_t)~(mem_word_t)0 / 0xFF)
+#define MEM_WORD_LOW7  (MEM_WORD_ONES * 0x7F)
+
+// sets the top bit of every zero byte of x and clears everything else,
+// without carries between bytes so both the first and last hit are exact
+static mem_word_t swar_zero_bytes(mem_word_t x) {
+  return ~(((x & MEM_WORD_LOW7) + MEM_WORD_LOW7) | x | MEM_WORD_LOW7);
+}
+
+// offset of the first differing byte, or length when the regions match
+static size_t diff_words(uint8_t * a, uint8_t * b, size_t length) {
+  size_t i = 0;
+  mem_word_t x;
+
+  while (length - i >= MEM_WORD_SIZE) {
+    x = *(mem_uword_t *)(a + i) ^ *(mem_uword_t *)(b + i);
+    if (x != 0) {
+      return i + MEM_WORD_CTZ(x) / 8;
+    }
+    i += MEM_WORD_SIZE;
+  }
+  while (i < length && a[i] == b[i]) {
+    i++;
+  }
+  return i;
+}
+
+// offset of the first byte equal to value, or length when there is none
+static size_t chr_words(uint8_t * src, size_t length, uint8_t value) {
+  mem_word_t pattern = (mem_word_t)value * MEM_WORD_ONES;
+  size_t i = 0;
+  mem_word_t z;
+
+  while (length - i >= MEM_WORD_SIZE) {
+    z = swar_zero_bytes(*(mem_uword_t *)(src + i) ^ pattern);
+    if (z != 0) {
+      return i + MEM_WORD_CTZ(z) / 8;
+    }
+    i += MEM_WORD_SIZE;
+  }
+  while (i < length && src[i] != value) {
+    i++;
+  }
+  return i;
+}
+
+// offset of the last byte equal to value, or length when there is none
+static size_t rchr_words(uint8_t * src, size_t length, uint8_t value) {
+  mem_word_t pattern = (mem_word_t)value * MEM_WORD_ONES;
+  size_t i = length;
+  mem_word_t z;
+
+  while (i >= MEM_WORD_SIZE) {
+    z = swar_zero_bytes(*(mem_uword_t *)(src + i - MEM_WORD_SIZE) ^ pattern);
+    if (z != 0) {
+      return i - 1 - MEM_WORD_CLZ(z) / 8;
+    }
+    i -= MEM_WORD_SIZE;
+  }
+  while (i > 0) {
+    i--;
+    if (src[i] == value) {
+      return i;
+    }
+  }
+  return length;
+}
+
+/***********************************************************
+ Vector Kernels (x86 HOST)
+***********************************************************/
+#if defined (MEM_X86)
+__attribute__((target("sse2")))
+static void copy_forward_sse2(uint8_t * src, uint8_t * dst, size_t length) {
+  __m128i a, b, c, d;
+
+  while (length > 0 && ((uintptr_t)dst & 15) != 0) {
+    *dst++ = *src++;
+    length--;
+  }
+  // every load of a block happens before any of its stores
+  while (length >= 64) {
+    a = _mm_loadu_si128((__m128i *)(src + 0));
+    b = _mm_loadu_si128((__m128i *)(src + 16));
+    c = _mm_loadu_si128((__m128i *)(src + 32));
+    d = _mm_loadu_si128((__m128i *)(src + 48));
+    _mm_store_si128((__m128i *)(dst + 0), a);
+    _mm_store_si128((__m128i *)(dst + 16), b);
+    _mm_store_si128((__m128i *)(dst + 32), c);
+    _mm_store_si128((__m128i *)(dst + 48), d);
+    src += 64;
+    dst += 64;
+    length -= 64;
+  }
+  while (length >= 16) {
+    _mm_store_si128((__m128i *)dst, _mm_loadu_si128((__m128i *)src));
+    src += 16;
+    dst += 16;
+    length -= 16;
+  }
+  copy_forward(src, dst, length);
+}
+
+__attribute__((target("sse2")))
+static void copy_backward_sse2(uint8_t * src, uint8_t * dst, size_t length) {
+  __m128i a, b, c, d;
+
+  src += length;
+  dst += length;
+  while (length > 0 && ((uintptr_t)dst & 15) != 0) {
+    *--dst = *--src;
+    length--;
+  }
+  while (length >= 64) {
+    src -= 64;
+    dst -= 64;
+    a = _mm_loadu_si128((__m128i *)(src + 48));
+    b = _mm_loadu_si128((__m128i *)(src + 32));
+    c = _mm_loadu_si128((__m128i *)(src + 16));
+    d = _mm_loadu_si128((__m128i *)(src + 0));
+    _mm_store_si128((__m128i *)(dst + 48), a);
+    _mm_store_si128((__m128i *)(dst + 32), b);
+    _mm_store_si128((__m128i *)(dst + 16), c);
+    _mm_store_si128((__m128i *)(dst + 0), d);
+    length -= 64;
+  }
+  while (length >= 16) {
+    src -= 16;
+    dst -= 16;
+    _mm_store_si128((__m128i *)dst, _mm_loadu_si128((__m128i *)src));
+    length -= 16;
+  }
+  copy_backward(src - length, dst - length, length);
+}
+
+__attribute__((target("sse2")))
+static void set_forward_sse2(uint8_t * dst, size_t length, uint8_t value) {
+  __m128i v = _mm_set1_epi8((char)value);
+
+  while (length > 0 && ((uintptr_t)dst & 15) != 0) {
+    *dst++ = value;
+    length--;
+  }
+  while (length >= 64) {
+    _mm_store_si128((__m128i *)(dst + 0), v);
+    _mm_store_si128((__m128i *)(dst + 16), v);
+    _mm_store_si128((__m128i *)(dst + 32), v);
+    _mm_store_si128((__m128i *)(dst + 48), v);
+    dst += 64;
+    length -= 64;
+  }
+  while (length >= 16) {
+    _mm_store_si128((__m128i *)dst, v);
+    dst += 16;
+    length -= 16;
+  }
+  set_forward(dst, length, value);
+}
+
+__attribute__((target("sse2")))
+static void set_stream_sse2(uint8_t * dst, size_t length, uint8_t value) {
+  __m128i v = _mm_set1_epi8((char)value);
+
+  while (length > 0 && ((uintptr_t)dst & 15) != 0) {
+    *dst++ = value;
+    length--;
+  }
+  // non-temporal stores bypass the cache on their way to memory
+  while (length >= 64) {
+    _mm_stream_si128((__m128i *)(dst + 0), v);
+    _mm_stream_si128((__m128i *)(dst + 16), v);
+    _mm_stream_si128((__m128i *)(dst + 32), v);
+    _mm_stream_si128((__m128i *)(dst + 48), v);
+    dst += 64;
+    length -= 64;
+  }
+  while (length >= 16) {
+    _mm_stream_si128((__m128i *)dst, v);
+    dst += 16;
+    length -= 16;
+  }
+  // order the streaming stores before anything that follows
+  _mm_sfence();
+  set_forward(dst, length, value);
+}
+
+// swap bytes within 16-bit lanes, then reverse the lanes and the halves
+__attribute__((target("sse2")))
+static __m128i bswap128_sse2(__m128i v) {
+  v = _mm_or_si128(_mm_slli_epi16(v, 8), _mm_srli_epi16(v, 8));
+  v = _mm_shufflelo_epi16(v, _MM_SHUFFLE(0, 1, 2, 3));
+  v = _mm_shufflehi_epi16(v, _MM_SHUFFLE(0, 1, 2, 3));
+  return _mm_shuffle_epi32(v, _MM_SHUFFLE(1, 0, 3, 2));
+}
+
+__attribute__((target("sse2")))
+static void reverse_sse2(uint8_t * src, size_t length) {
+  uint8_t * lo = src;
+  uint8_t * hi = src + length;
+  __m128i a, b;
+
+  while (hi - lo >= 32) {
+    a = _mm_loadu_si128((__m128i *)lo);
+    b = _mm_loadu_si128((__m128i *)(hi - 16));
+    _mm_storeu_si128((__m128i *)lo, bswap128_sse2(b));
+    _mm_storeu_si128((__m128i *)(hi - 16), bswap128_sse2(a));
+    lo += 16;
+    hi -= 16;
+  }
+  reverse_words(lo, hi - lo);
+}
+
+// one unaligned head store, aligned stores in the middle and an unaligned
+// tail store, each with the pattern rotated to the phase of its address
+__attribute__((target("sse2")))
+static void fill_sse2(uint8_t * dst, size_t length, uint64_t pattern) {
+  uint8_t * end = dst + length;
+  uint8_t * p;
+
+  if (length < 16) {
+    fill_forward(dst, length, pattern);
+    return;
+  }
+  _mm_storeu_si128((__m128i *)dst, _mm_set1_epi64x((long long)pattern));
+  p = (uint8_t *)(((uintptr_t)dst + 16) & ~(uintptr_t)15);
+  if (end - p >= 16) {
+    __m128i v = _mm_set1_epi64x((long long)pattern_phase(pattern, (size_t)(p - dst)));
+    while (end - p >= 16) {
+      _mm_store_si128((__m128i *)p, v);
+      p += 16;
+    }
+  }
+  _mm_storeu_si128((__m128i *)(end - 16),
+                   _mm_set1_epi64x((long long)pattern_phase(pattern, length - 16)));
+}
+
+// reverse the order of the 2, 4 or 8 byte elements of a vector
+__attribute__((target("sse2")))
+static __m128i reverse128_sse2(__m128i v, size_t width) {
+  if (width == 2) {
+    v = _mm_shufflelo_epi16(v, _MM_SHUFFLE(0, 1, 2, 3));
+    v = _mm_shufflehi_epi16(v, _MM_SHUFFLE(0, 1, 2, 3));
+    return _mm_shuffle_epi32(v, _MM_SHUFFLE(1, 0, 3, 2));
+  }
+  if (width == 4) {
+    return _mm_shuffle_epi32(v, _MM_SHUFFLE(0, 1, 2, 3));
+  }
+  return _mm_shuffle_epi32(v, _MM_SHUFFLE(1, 0, 3, 2));
+}
+
+// byte swap each 2, 4 or 8 byte element of a vector in place
+__attribute__((target("sse2")))
+static __m128i bswap_elems128_sse2(__m128i v, size_t width) {
+  v = _mm_or_si128(_mm_slli_epi16(v, 8), _mm_srli_epi16(v, 8));
+  if (width == 4) {
+    v = _mm_shufflelo_epi16(v, _MM_SHUFFLE(2, 3, 0, 1));
+    return _mm_shufflehi_epi16(v, _MM_SHUFFLE(2, 3, 0, 1));
+  }
+  if (width == 8) {
+    v = _mm_shufflelo_epi16(v, _MM_SHUFFLE(0, 1, 2, 3));
+    return _mm_shufflehi_epi16(v, _MM_SHUFFLE(0, 1, 2, 3));
+  }
+  return v;
+}
+
+__attribute__((target("sse2")))
+static void reverse_elems_sse2(uint8_t * src, size_t count, size_t width) {
+  uint8_t * lo = src;
+  uint8_t * hi = src + count * width;
+  __m128i a, b;
+
+  while (hi - lo >= 32) {
+    a = _mm_loadu_si128((__m128i *)lo);
+    b = _mm_loadu_si128((__m128i *)(hi - 16));
+    _mm_storeu_si128((__m128i *)lo, reverse128_sse2(b, width));
+    _mm_storeu_si128((__m128i *)(hi - 16), reverse128_sse2(a, width));
+    lo += 16;
+    hi -= 16;
+  }
+  reverse_elems(lo, (size_t)(hi - lo) / width, width);
+}
+
+__attribute__((target("sse2")))
+static void bswap_elems_sse2(uint8_t * src, size_t count, size_t width) {
+  size_t length = count * width;
+
+  while (length >= 16) {
+    _mm_storeu_si128((__m128i *)src,
+                     bswap_elems128_sse2(_mm_loadu_si128((__m128i *)src), width));
+    src += 16;
+    length -= 16;
+  }
+  bswap_elems(src, length / width, width);
+}
+
+__attribute__((target("sse2")))
+static void swap_sse2(uint8_t * a, uint8_t * b, size_t length) {
+  __m128i x0, x1, y0, y1;
+
+  while (length >= 32) {
+    x0 = _mm_loadu_si128((__m128i *)a);
+    x1 = _mm_loadu_si128((__m128i *)(a + 16));
+    y0 = _mm_loadu_si128((__m128i *)b);
+    y1 = _mm_loadu_si128((__m128i *)(b + 16));
+    _mm_storeu_si128((__m128i *)a, y0);
+    _mm_storeu_si128((__m128i *)(a + 16), y1);
+    _mm_storeu_si128((__m128i *)b, x0);
+    _mm_storeu_si128((__m128i *)(b + 16), x1);
+    a += 32;
+    b += 32;
+    length -= 32;
+  }
+  swap_words(a, b, length);
+}
+
+// 2 channels with shifts and packs only, 16 frames (8-bit) or 8 frames
+// (16-bit) per step, returns the frames done
+__attribute__((target("sse2")))
+static size_t deinterleave2_sse2(uint8_t * src, uint8_t * even, uint8_t * odd,
+                                 size_t frames, size_t width) {
+  __m128i a, b, low;
+  size_t step = 16 / width;
+  size_t done = 0;
+
+  low = _mm_set1_epi16(0x00FF);
+  while (frames - done >= step) {
+    a = _mm_loadu_si128((__m128i *)(src + 2 * done * width));
+    b = _mm_loadu_si128((__m128i *)(src + 2 * done * width + 16));
+    if (width == 1) {
+      _mm_storeu_si128((__m128i *)(even + done), _mm_packus_epi16(_mm_and_si128(a, low), _mm_and_si128(b, low)));
+      _mm_storeu_si128((__m128i *)(odd + done), _mm_packus_epi16(_mm_srli_epi16(a, 8), _mm_srli_epi16(b, 8)));
+    } else {
+      // sign extended halves pack back exactly with signed saturation
+      _mm_storeu_si128((__m128i *)(even + 2 * done),
+                       _mm_packs_epi32(_mm_srai_epi32(_mm_slli_epi32(a, 16), 16),
+                                       _mm_srai_epi32(_mm_slli_epi32(b, 16), 16)));
+      _mm_storeu_si128((__m128i *)(odd + 2 * done),
+                       _mm_packs_epi32(_mm_srai_epi32(a, 16), _mm_srai_epi32(b, 16)));
+    }
+    done += step;
+  }
+  return done;
+}
+
+__attribute__((target("sse2")))
+static size_t interleave2_sse2(uint8_t * even, uint8_t * odd, uint8_t * dst,
+                               size_t frames, size_t width) {
+  __m128i a, b;
+  size_t step = 16 / width;
+  size_t done = 0;
+
+  while (frames - done >= step) {
+    a = _mm_loadu_si128((__m128i *)(even + done * width));
+    b = _mm_loadu_si128((__m128i *)(odd + done * width));
+    if (width == 1) {
+      _mm_storeu_si128((__m128i *)(dst + 2 * done), _mm_unpacklo_epi8(a, b));
+      _mm_storeu_si128((__m128i *)(dst + 2 * done + 16), _mm_unpackhi_epi8(a, b));
+    } else {
+      _mm_storeu_si128((__m128i *)(dst + 4 * done), _mm_unpacklo_epi16(a, b));
+      _mm_storeu_si128((__m128i *)(dst + 4 * done + 16), _mm_unpackhi_epi16(a, b));
+    }
+    done += step;
+  }
+  return done;
+}
+
+// the SSE2 kernels only know 2 channels
+static size_t deinterleave_sse2(uint8_t * src, uint8_t ** planes, size_t channels,
+                                size_t frames, size_t width) {
+  if (channels != 2) {
+    return 0;
+  }
+  return deinterleave2_sse2(src, planes[0], planes[1], frames, width);
+}
+
+static size_t interleave_sse2(uint8_t ** planes, uint8_t * dst, size_t channels,
+                              size_t frames, size_t width) {
+  if (channels != 2) {
+    return 0;
+  }
+  return interleave2_sse2(planes[0], planes[1], dst, frames, width);
+}
+
+// compare 16 bytes per step, movemask turns the byte lanes into bits
+__attribute__((target("sse2")))
+static size_t diff_sse2(uint8_t * a, uint8_t * b, size_t length) {
+  size_t i = 0;
+  unsigned int mask;
+
+  while (length - i >= 16) {
+    mask = (unsigned int)_mm_movemask_epi8(_mm_cmpeq_epi8(
+             _mm_loadu_si128((__m128i *)(a + i)), _mm_loadu_si128((__m128i *)(b + i))));
+    if (mask != 0xFFFF) {
+      return i + (size_t)__builtin_ctz(~mask);
+    }
+    i += 16;
+  }
+  return i + diff_words(a + i, b + i, length - i);
+}
+
+__attribute__((target("sse2")))
+static size_t chr_sse2(uint8_t * src, size_t length, uint8_t value) {
+  __m128i v = _mm_set1_epi8((char)value);
+  size_t i = 0;
+  unsigned int mask;
+
+  while (length - i >= 16) {
+    mask = (unsigned int)_mm_movemask_epi8(_mm_cmpeq_epi8(_mm_loadu_si128((__m128i *)(src + i)), v));
+    if (mask != 0) {
+      return i + (size_t)__builtin_ctz(mask);
+    }
+    i += 16;
+  }
+  return i + chr_words(src + i, length - i, value);
+}
+
+__attribute__((target("sse2")))
+static size_t rchr_sse2(uint8_t * src, size_t length, uint8_t value) {
+  __m128i v = _mm_set1_epi8((char)value);
+  size_t i = length;
+  size_t hit;
+  unsigned int mask;
+
+  while (i >= 16) {
+    mask = (unsigned int)_mm_movemask_epi8(_mm_cmpeq_epi8(_mm_loadu_si128((__m128i *)(src + i - 16)), v));
+    if (mask != 0) {
+      return i - 16 + (size_t)(31 - __builtin_clz(mask));
+    }
+    i -= 16;
+  }
+  hit = rchr_words(src, i, value);
+  return (hit == i) ? length : hit;
+}
+
+__attribute__((target("avx2")))
+static void copy_forward_avx2(uint8_t * src, uint8_t * dst, size_t length) {
+  __m256i a, b, c, d;
+
+  while (length > 0 && ((uintptr_t)dst & 31) != 0) {
+    *dst++ = *src++;
+    length--;
+  }
+  while (length >= 128) {
+    a = _mm256_loadu_si256((__m256i *)(src + 0));
+    b = _mm256_loadu_si256((__m256i *)(src + 32));
+    c = _mm256_loadu_si256((__m256i *)(src + 64));
+    d = _mm256_loadu_si256((__m256i *)(src + 96));
+    _mm256_store_si256((__m256i *)(dst + 0), a);
+    _mm256_store_si256((__m256i *)(dst + 32), b);
+    _mm256_store_si256((__m256i *)(dst + 64), c);
+    _mm256_store_si256((__m256i *)(dst + 96), d);
+    src += 128;
+    dst += 128;
+    length -= 128;
+  }
+  while (length >= 32) {
+    _mm256_store_si256((__m256i *)dst, _mm256_loadu_si256((__m256i *)src));
+    src += 32;
+    dst += 32;
+    length -= 32;
+  }
+  copy_forward(src, dst, length);
+}
+
+__attribute__((target("avx2")))
+static void copy_backward_avx2(uint8_t * src, uint8_t * dst, size_t length) {
+  __m256i a, b, c, d;
+
+  src += length;
+  dst += length;
+  while (length > 0 && ((uintptr_t)dst & 31) != 0) {
+    *--dst = *--src;
+    length--;
+  }
+  while (length >= 128) {
+    src -= 128;
+    dst -= 128;
+    a = _mm256_loadu_si256((__m256i *)(src + 96));
+    b = _mm256_loadu_si256((__m256i *)(src + 64));
+    c = _mm256_loadu_si256((__m256i *)(src + 32));
+    d = _mm256_loadu_si256((__m256i *)(src + 0));
+    _mm256_store_si256((__m256i *)(dst + 96), a);
+    _mm256_store_si256((__m256i *)(dst + 64), b);
+    _mm256_store_si256((__m256i *)(dst + 32), c);
+    _mm256_store_si256((__m256i *)(dst + 0), d);
+    length -= 128;
+  }
+  while (length >= 32) {
+    src -= 32;
+    dst -= 32;
+    _mm256_store_si256((__m256i *)dst, _mm256_loadu_si256((__m256i *)src));
+    length -= 32;
+  }
+  copy_backward(src - length, dst - length, length);
+}
+
+__attribute__((target("avx2")))
+static void set_forward_avx2(uint8_t * dst, size_t length, uint8_t value) {
+  __m256i v = _mm256_set1_epi8((char)value);
+
+  while (length > 0 && ((uintptr_t)dst & 31) != 0) {
+    *dst++ = value;
+    length--;
+  }
+  while (length >= 128) {
+    _mm256_store_si256((__m256i *)(dst + 0), v);
+    _mm256_store_si256((__m256i *)(dst + 32), v);
+    _mm256_store_si256((__m256i *)(dst + 64), v);
+    _mm256_store_si256((__m256i *)(dst + 96), v);
+    dst += 128;
+    length -= 128;
+  }
+  while (length >= 32) {
+    _mm256_store_si256((__m256i *)dst, v);
+    dst += 32;
+    length -= 32;
+  }
+  set_forward(dst, length, value);
+}
+
+__attribute__((target("avx2")))
+static void set_stream_avx2(uint8_t * dst, size_t length, uint8_t value) {
+  __m256i v = _mm256_set1_epi8((char)value);
+
+  while (length > 0 && ((uintptr_t)dst & 31) != 0) {
+    *dst++ = value;
+    length--;
+  }
+  while (length >= 128) {
+    _mm256_stream_si256((__m256i *)(dst + 0), v);
+    _mm256_stream_si256((__m256i *)(dst + 32), v);
+    _mm256_stream_si256((__m256i *)(dst + 64), v);
+    _mm256_stream_si256((__m256i *)(dst + 96), v);
+    dst += 128;
+    length -= 128;
+  }
+  while (length >= 32) {
+    _mm256_stream_si256((__m256i *)dst, v);
+    dst += 32;
+    length -= 32;
+  }
+  _mm_sfence();
+  set_forward(dst, length, value);
+}
+
+// reverse each 128-bit lane with a byte shuffle, then swap the lanes
+__attribute__((target("avx2")))
+static __m256i bswap256_avx2(__m256i v) {
+  const __m256i mask = _mm256_setr_epi8(15, 14, 13, 12, 11, 10, 9, 8,
+                                        7, 6, 5, 4, 3, 2, 1, 0,
+                                        15, 14, 13, 12, 11, 10, 9, 8,
+                                        7, 6, 5, 4, 3, 2, 1, 0);
+
+  v = _mm256_shuffle_epi8(v, mask);
+  return _mm256_permute4x64_epi64(v, _MM_SHUFFLE(1, 0, 3, 2));
+}
+
+__attribute__((target("avx2")))
+static void reverse_avx2(uint8_t * src, size_t length) {
+  uint8_t * lo = src;
+  uint8_t * hi = src + length;
+  __m256i a, b;
+
+  while (hi - lo >= 64) {
+    a = _mm256_loadu_si256((__m256i *)lo);
+    b = _mm256_loadu_si256((__m256i *)(hi - 32));
+    _mm256_storeu_si256((__m256i *)lo, bswap256_avx2(b));
+    _mm256_storeu_si256((__m256i *)(hi - 32), bswap256_avx2(a));
+    lo += 32;
+    hi -= 32;
+  }
+  reverse_sse2(lo, hi - lo);
+}
+
+__attribute__((target("avx2")))
+static void fill_avx2(uint8_t * dst, size_t length, uint64_t pattern) {
+  uint8_t * end = dst + length;
+  uint8_t * p;
+
+  if (length < 32) {
+    fill_sse2(dst, length, pattern);
+    return;
+  }
+  _mm256_storeu_si256((__m256i *)dst, _mm256_set1_epi64x((long long)pattern));
+  p = (uint8_t *)(((uintptr_t)dst + 32) & ~(uintptr_t)31);
+  if (end - p >= 32) {
+    __m256i v = _mm256_set1_epi64x((long long)pattern_phase(pattern, (size_t)(p - dst)));
+    while (end - p >= 32) {
+      _mm256_store_si256((__m256i *)p, v);
+      p += 32;
+    }
+  }
+  _mm256_storeu_si256((__m256i *)(end - 32),
+                      _mm256_set1_epi64x((long long)pattern_phase(pattern, length - 32)));
+}
+
+// byte shuffle masks that byte swap every 2, 4 or 8 byte element of a lane
+__attribute__((target("avx2")))
+static __m256i bswap_mask_avx2(size_t width) {
+  if (width == 2) {
+    return _mm256_setr_epi8(1, 0, 3, 2, 5, 4, 7, 6, 9, 8, 11, 10, 13, 12, 15, 14,
+                            1, 0, 3, 2, 5, 4, 7, 6, 9, 8, 11, 10, 13, 12, 15, 14);
+  }
+  if (width == 4) {
+    return _mm256_setr_epi8(3, 2, 1, 0, 7, 6, 5, 4, 11, 10, 9, 8, 15, 14, 13, 12,
+                            3, 2, 1, 0, 7, 6, 5, 4, 11, 10, 9, 8, 15, 14, 13, 12);
+  }
+  return _mm256_setr_epi8(7, 6, 5, 4, 3, 2, 1, 0, 15, 14, 13, 12, 11, 10, 9, 8,
+                          7, 6, 5, 4, 3, 2, 1, 0, 15, 14, 13, 12, 11, 10, 9, 8);
+}
+
+// element order reversal is a full byte reversal followed by a byte swap
+// of every element, which puts the element bytes back in their order
+__attribute__((target("avx2")))
+static void reverse_elems_avx2(uint8_t * src, size_t count, size_t width) {
+  uint8_t * lo = src;
+  uint8_t * hi = src + count * width;
+  __m256i mask = bswap_mask_avx2(width);
+  __m256i a, b;
+
+  while (hi - lo >= 64) {
+    a = _mm256_loadu_si256((__m256i *)lo);
+    b = _mm256_loadu_si256((__m256i *)(hi - 32));
+    _mm256_storeu_si256((__m256i *)lo, _mm256_shuffle_epi8(bswap256_avx2(b), mask));
+    _mm256_storeu_si256((__m256i *)(hi - 32), _mm256_shuffle_epi8(bswap256_avx2(a), mask));
+    lo += 32;
+    hi -= 32;
+  }
+  reverse_elems_sse2(lo, (size_t)(hi - lo) / width, width);
+}
+
+__attribute__((target("avx2")))
+static void bswap_elems_avx2(uint8_t * src, size_t count, size_t width) {
+  size_t length = count * width;
+  __m256i mask = bswap_mask_avx2(width);
+
+  while (length >= 32) {
+    _mm256_storeu_si256((__m256i *)src,
+                        _mm256_shuffle_epi8(_mm256_loadu_si256((__m256i *)src), mask));
+    src += 32;
+    length -= 32;
+  }
+  bswap_elems_sse2(src, length / width, width);
+}
+
+__attribute__((target("avx2")))
+static void swap_avx2(uint8_t * a, uint8_t * b, size_t length) {
+  __m256i x0, x1, y0, y1;
+
+  while (length >= 64) {
+    x0 = _mm256_loadu_si256((__m256i *)a);
+    x1 = _mm256_loadu_si256((__m256i *)(a + 32));
+    y0 = _mm256_loadu_si256((__m256i *)b);
+    y1 = _mm256_loadu_si256((__m256i *)(b + 32));
+    _mm256_storeu_si256((__m256i *)a, y0);
+    _mm256_storeu_si256((__m256i *)(a + 32), y1);
+    _mm256_storeu_si256((__m256i *)b, x0);
+    _mm256_storeu_si256((__m256i *)(b + 32), x1);
+    a += 64;
+    b += 64;
+    length -= 64;
+  }
+  swap_sse2(a, b, length);
+}
+
+// the 256 entry table is split into 16 rows of 16 and each row is looked
+// up with a byte shuffle on the low nibble. The index is lowered by 16
+// per row and biased with a saturating add of 0x70, which leaves bit 7
+// clear only in lanes whose byte falls in the current row; the shuffle
+// zeroes every other lane, so the rows can simply be or'ed together.
+// Two vectors per step keep the shuffle port busy, about 1.5x the table
+// walk (see bench_xlat)
+__attribute__((target("avx2")))
+static void xlat_avx2(uint8_t * src, uint8_t * dst, size_t length, uint8_t * table) {
+  __m256i rows[16];
+  __m256i step = _mm256_set1_epi8(0x10);
+  __m256i bias = _mm256_set1_epi8(0x70);
+  __m256i i0, i1, o0, o1;
+  int h;
+
+  for (h = 0; h < 16; h++) {
+    rows[h] = _mm256_broadcastsi128_si256(_mm_loadu_si128((__m128i *)(table + 16 * h)));
+  }
+  while (length >= 64) {
+    i0 = _mm256_loadu_si256((__m256i *)src);
+    i1 = _mm256_loadu_si256((__m256i *)(src + 32));
+    o0 = _mm256_setzero_si256();
+    o1 = _mm256_setzero_si256();
+    for (h = 0; h < 16; h++) {
+      o0 = _mm256_or_si256(o0, _mm256_shuffle_epi8(rows[h], _mm256_adds_epu8(i0, bias)));
+      o1 = _mm256_or_si256(o1, _mm256_shuffle_epi8(rows[h], _mm256_adds_epu8(i1, bias)));
+      i0 = _mm256_sub_epi8(i0, step);
+      i1 = _mm256_sub_epi8(i1, step);
+    }
+    _mm256_storeu_si256((__m256i *)dst, o0);
+    _mm256_storeu_si256((__m256i *)(dst + 32), o1);
+    src += 64;
+    dst += 64;
+    length -= 64;
+  }
+  xlat_words(src, dst, length, table);
+}
+
+// channel shuffles are built per call: for deinterleave, masks[c][v] picks
+// the bytes of channel c out of input vector v; for interleave,
+// masks[v][c] picks the bytes of output vector v out of channel c
+static void channel_masks(uint8_t masks[4][4][16], size_t channels, size_t width, int interleave) {
+  size_t v, b, pos;
+
+  for (v = 0; v < 4; v++) {
+    for (b = 0; b < 4 * 16; b++) {
+      masks[v][b / 16][b % 16] = 0x80;
+    }
+  }
+  for (v = 0; v < channels; v++) {
+    for (b = 0; b < 16; b++) {
+      if (interleave) {
+        // byte b of output vector v comes from frame pos / channels
+        pos = (16 * v + b) / width;
+        masks[v][pos % channels][b] = (uint8_t)((pos / channels) * width + b % width);
+      } else {
+        // byte b of channel v comes from input byte pos
+        pos = ((b / width) * channels + v) * width + b % width;
+        masks[v][pos / 16][b] = (uint8_t)(pos % 16);
+      }
+    }
+  }
+}
+
+// 2 to 4 channels, 32 bytes of every channel per step, returns the frames
+// done. A byte shuffle cannot cross the 128-bit lanes, so the lanes are
+// arranged on load (deinterleave) or on store (interleave) so that lane 0
+// holds the first 16 bytes of every channel and lane 1 the next 16; the
+// same 16-byte masks then serve both lanes
+__attribute__((target("avx2")))
+static size_t deinterleave_avx2(uint8_t * src, uint8_t ** planes, size_t channels,
+                                size_t frames, size_t width) {
+  uint8_t masks[4][4][16];
+  __m256i in[4];
+  __m256i out;
+  size_t step = 32 / width;
+  size_t done = 0;
+  size_t c, v;
+  uint8_t * base;
+
+  if (channels < 2 || channels > 4) {
+    return 0;
+  }
+  channel_masks(masks, channels, width, 0);
+  while (frames - done >= step) {
+    base = src + done * channels * width;
+    for (v = 0; v < channels; v++) {
+      in[v] = _mm256_inserti128_si256(_mm256_castsi128_si256(_mm_loadu_si128((__m128i *)(base + 16 * v))),
+                                      _mm_loadu_si128((__m128i *)(base + 16 * (channels + v))), 1);
+    }
+    for (c = 0; c < channels; c++) {
+      out = _mm256_setzero_si256();
+      for (v = 0; v < channels; v++) {
+        out = _mm256_or_si256(out, _mm256_shuffle_epi8(in[v],
+                _mm256_broadcastsi128_si256(_mm_loadu_si128((__m128i *)masks[c][v]))));
+      }
+      _mm256_storeu_si256((__m256i *)(planes[c] + done * width), out);
+    }
+    done += step;
+  }
+  return done;
+}
+
+__attribute__((target("avx2")))
+static size_t interleave_avx2(uint8_t ** planes, uint8_t * dst, size_t channels,
+                              size_t frames, size_t width) {
+  uint8_t masks[4][4][16];
+  __m256i in[4];
+  __m256i out;
+  size_t step = 32 / width;
+  size_t done = 0;
+  size_t c, v;
+  uint8_t * base;
+
+  if (channels < 2 || channels > 4) {
+    return 0;
+  }
+  channel_masks(masks, channels, width, 1);
+  while (frames - done >= step) {
+    base = dst + done * channels * width;
+    for (c = 0; c < channels; c++) {
+      in[c] = _mm256_loadu_si256((__m256i *)(planes[c] + done * width));
+    }
+    for (v = 0; v < channels; v++) {
+      out = _mm256_setzero_si256();
+      for (c = 0; c < channels; c++) {
+        out = _mm256_or_si256(out, _mm256_shuffle_epi8(in[c],
+                _mm256_broadcastsi128_si256(_mm_loadu_si128((__m128i *)masks[v][c]))));
+      }
+      _mm_storeu_si128((__m128i *)(base + 16 * v), _mm256_castsi256_si128(out));
+      _mm_storeu_si128((__m128i *)(base + 16 * (channels + v)), _mm256_extracti128_si256(out, 1));
+    }
+    done += step;
+  }
+  return done;
+}
+
+__attribute__((target("avx2")))
+static size_t diff_avx2(uint8_t * a, uint8_t * b, size_t length) {
+  size_t i = 0;
+  unsigned int mask;
+
+  while (length - i >= 32) {
+    mask = (unsigned int)_mm256_movemask_epi8(_mm256_cmpeq_epi8(
+             _mm256_loadu_si256((__m256i *)(a + i)), _mm256_loadu_si256((__m256i *)(b + i))));
+    if (mask != 0xFFFFFFFFu) {
+      return i + (size_t)__builtin_ctz(~mask);
+    }
+    i += 32;
+  }
+  return i + diff_sse2(a + i, b + i, length - i);
+}
+
+__attribute__((target("avx2")))
+static size_t chr_avx2(uint8_t * src, size_t length, uint8_t value) {
+  __m256i v = _mm256_set1_epi8((char)value);
+  size_t i = 0;
+  unsigned int mask;
+
+  while (length - i >= 32) {
+    mask = (unsigned int)_mm256_movemask_epi8(_mm256_cmpeq_epi8(_mm256_loadu_si256((__m256i *)(src + i)), v));
+    if (mask != 0) {
+      return i + (size_t)__builtin_ctz(mask);
+    }
+    i += 32;
+  }
+  return i + chr_sse2(src + i, length - i, value);
+}
+
+__attribute__((target("avx2")))
+static size_t rchr_avx2(uint8_t * src, size_t length, uint8_t value) {
+  __m256i v = _mm256_set1_epi8((char)value);
+  size_t i = length;
+  size_t hit;
+  unsigned int mask;
+
+  while (i >= 32) {
+    mask = (unsigned int)_mm256_movemask_epi8(_mm256_cmpeq_epi8(_mm256_loadu_si256((__m256i *)(src + i - 32)), v));
+    if (mask != 0) {
+      return i - 32 + (size_t)(31 - __builtin_clz(mask));
+    }
+    i -= 32;
+  }
+  hit = rchr_sse2(src, i, value);
+  return (hit == i) ? length : hit;
+}
+#endif /* MEM_X86 */
+
+// no scalar kernel, the callers finish every frame a kernel leaves
+static size_t deinterleave_none(uint8_t * src, uint8_t ** planes, size_t channels,
+                                size_t frames, size_t width) {
+  (void)src;
+  (void)planes;
+  (void)channels;
+  (void)frames;
+  (void)width;
+  return 0;
+}
+
+static size_t interleave_none(uint8_t ** planes, uint8_t * dst, size_t channels,
+                              size_t frames, size_t width) {
+  (void)planes;
+  (void)dst;
+  (void)channels;
+  (void)frames;
+  (void)width;
+  return 0;
+}
+
+/***********************************************************
+ Kernel Dispatch
+***********************************************************/
+typedef struct {
+  void (*copy_forward)(uint8_t * src, uint8_t * dst, size_t length);
+  void (*copy_backward)(uint8_t * src, uint8_t * dst, size_t length);
+  void (*set)(uint8_t * dst, size_t length, uint8_t value);
+  void (*set_stream)(uint8_t * dst, size_t length, uint8_t value);
+  void (*reverse)(uint8_t * src, size_t length);
+  void (*reverse_elems)(uint8_t * src, size_t count, size_t width);
+  void (*bswap_elems)(uint8_t * src, size_t count, size_t width);
+  void (*fill)(uint8_t * dst, size_t length, uint64_t pattern);
+  size_t (*diff)(uint8_t * a, uint8_t * b, size_t length);
+  size_t (*chr)(uint8_t * src, size_t length, uint8_t value);
+  size_t (*rchr)(uint8_t * src, size_t length, uint8_t value);
+  void (*swap)(uint8_t * a, uint8_t * b, size_t length);
+  void (*xlat)(uint8_t * src, uint8_t * dst, size_t length, uint8_t * table);
+  // return the frames done
+  size_t (*deinterleave)(uint8_t * src, uint8_t ** planes, size_t channels, size_t frames, size_t width);
+  size_t (*interleave)(uint8_t ** planes, uint8_t * dst, size_t channels, size_t frames, size_t width);
+} mem_kernels_t;
+
+// scalar until the startup probe below has run
+static mem_impl_t mem_impl = MEM_IMPL_SCALAR;
+static mem_kernels_t mem_kernels = {
+  copy_forward, copy_backward, set_forward, set_forward, reverse_words,
+  reverse_elems, bswap_elems, fill_forward, diff_words, chr_words, rchr_words,
+  swap_words, xlat_words, deinterleave_none, interleave_none
+};
+
+// sets at least this large bypass the cache, zero disables streaming
+static size_t mem_stream_threshold = MEM_STREAM_THRESHOLD;
+
+static mem_impl_t mem_impl_best(void) {
+#if defined (MEM_X86)
+  __builtin_cpu_init();
+  if (__builtin_cpu_supports("avx2")) {
+    return MEM_IMPL_AVX2;
+  }
+  if (__builtin_cpu_supports("sse2")) {
+    return MEM_IMPL_SSE2;
+  }
+#endif
+  return MEM_IMPL_SCALAR;
+}
+
+mem_impl_t my_mem_select(mem_impl_t impl) {
+  mem_impl_t best = mem_impl_best();
+
+  // never select a kernel this cpu cannot run
+  if (impl > best) {
+    impl = best;
+  }
+  switch (impl) {
+#if defined (MEM_X86)
+  case MEM_IMPL_AVX2:
+    mem_kernels.copy_forward = copy_forward_avx2;
+    mem_kernels.copy_backward = copy_backward_avx2;
+    mem_kernels.set = set_forward_avx2;
+    mem_kernels.set_stream = set_stream_avx2;
+    mem_kernels.reverse = reverse_avx2;
+    mem_kernels.reverse_elems = reverse_elems_avx2;
+    mem_kernels.bswap_elems = bswap_elems_avx2;
+    mem_kernels.fill = fill_avx2;
+    mem_kernels.diff = diff_avx2;
+    mem_kernels.chr = chr_avx2;
+    mem_kernels.rchr = rchr_avx2;
+    mem_kernels.swap = swap_avx2;
+    mem_kernels.xlat = xlat_avx2;
+    mem_kernels.deinterleave = deinterleave_avx2;
+    mem_kernels.interleave = interleave_avx2;
+    break;
+  case MEM_IMPL_SSE2:
+    mem_kernels.copy_forward = copy_forward_sse2;
+    mem_kernels.copy_backward = copy_backward_sse2;
+    mem_kernels.set = set_forward_sse2;
+    mem_kernels.set_stream = set_stream_sse2;
+    mem_kernels.reverse = reverse_sse2;
+    mem_kernels.reverse_elems = reverse_elems_sse2;
+    mem_kernels.bswap_elems = bswap_elems_sse2;
+    mem_kernels.fill = fill_sse2;
+    mem_kernels.diff = diff_sse2;
+    mem_kernels.chr = chr_sse2;
+    mem_kernels.rchr = rchr_sse2;
+    mem_kernels.swap = swap_sse2;
+    mem_kernels.xlat = xlat_words;
+    mem_kernels.deinterleave = deinterleave_sse2;
+    mem_kernels.interleave = interleave_sse2;
+    break;
+#endif
+  default:
+    impl = MEM_IMPL_SCALAR;
+    mem_kernels.copy_forward = copy_forward;
+    mem_kernels.copy_backward = copy_backward;
+    mem_kernels.set = set_forward;
+    mem_kernels.set_stream = set_forward;
+    mem_kernels.reverse = reverse_words;
+    mem_kernels.reverse_elems = reverse_elems;
+    mem_kernels.bswap_elems = bswap_elems;
+    mem_kernels.fill = fill_forward;
+    mem_kernels.diff = diff_words;
+    mem_kernels.chr = chr_words;
+    mem_kernels.rchr = rchr_words;
+    mem_kernels.swap = swap_words;
+    mem_kernels.xlat = xlat_words;
+    mem_kernels.deinterleave = deinterleave_none;
+    mem_kernels.interleave = interleave_none;
+    break;
+  }
+  mem_impl = impl;
+  return impl;
+}
+
+mem_impl_t my_mem_impl(void) {
+  return mem_impl;
+}
+
+size_t my_mem_set_stream_threshold(size_t threshold) {
+  size_t previous = mem_stream_threshold;
+
+  mem_stream_threshold = threshold;
+  return previous;
 }
 
+#if defined (MEM_X86)
+// pick the widest kernels once, before main runs
+__attribute__((constructor))
+static void mem_dispatch_init(void) {
+  my_mem_select(MEM_IMPL_AVX2);
+}
+#endif
 
 /* placeholder for new functions */
 uint8_t * my_memmove(uint8_t * src, uint8_t * dst, size_t length) {
@@ -57,20 +1527,20 @@ uint8_t * my_memmove(uint8_t * src, uint8_t * dst, size_t length) {
   if (src == dst || length == 0) {
     return dst; // No operation needed if src and dst are the same or length is zero
   }
+  // Small moves load everything up front, so overlap does not matter
+  if (length <= MEM_SMALL_SIZE) {
+    copy_small(src, dst, length);
+    return dst;
+  }
   // Check for overlap
   if (src < dst && (src + length) > dst) {
     // Overlapping regions, copy backwards
-    for (size_t i = length; i > 0; i--) {
-      *(dst + i - 1) = *(src + i - 1);
-    }
+    mem_kernels.copy_backward(src, dst, length);
   } else {
     // Non-overlapping regions, copy forwards
-    for (size_t i = 0; i < length; i++) {
-      *(dst + i) = *(src + i);
-    }
-  }   
-  
-  //
+    mem_kernels.copy_forward(src, dst, length);
+  }
+
   return dst;
 }
 
@@ -80,17 +1550,23 @@ uint8_t * my_memcopy(uint8_t * src, uint8_t * dst, size_t length) {
     return dst; // No operation needed if src and dst are the same or length is zero
   }
   // Non-overlapping regions, copy forwards
-  for (size_t i = 0; i < length; i++) {
-    *(dst + i) = *(src + i);
+  if (length <= MEM_SMALL_SIZE) {
+    copy_small(src, dst, length);
+  } else {
+    mem_kernels.copy_forward(src, dst, length);
   }
 
   return dst;
 }
 
 uint8_t * my_memset(uint8_t * src, size_t length, uint8_t value) {
-  // set length of bytes in src to defined value
-  for (size_t i = 0; i < length; i++) {
-    *(src + i) = value;
+  // set length of bytes in src to defined value, streaming when very large
+  if (length <= MEM_SMALL_SIZE) {
+    set_small(src, length, value);
+  } else if (mem_stream_threshold != 0 && length >= mem_stream_threshold) {
+    mem_kernels.set_stream(src, length, value);
+  } else {
+    mem_kernels.set(src, length, value);
   }
   //return pointer to src 
   return src;
@@ -98,34 +1574,686 @@ uint8_t * my_memset(uint8_t * src, size_t length, uint8_t value) {
 
 uint8_t * my_memzero(uint8_t * src, size_t length) {
   // set length of bytes in src to zero
-  for (size_t i = 0; i < length; i++) {
-    *(src + i) = 0;
+  return my_memset(src, length, 0);
+}
+
+uint8_t * my_memzero_stream(uint8_t * src, size_t length) {
+  // zero without pulling the region into the cache, whatever its size
+  mem_kernels.set_stream(src, length, 0);
+  return src;
+}
+
+uint16_t * my_memset16(uint16_t * src, size_t length, uint16_t value) {
+  // broadcast the element into a 64-bit pattern and fill at full width
+  mem_kernels.fill((uint8_t *)src, length * sizeof(uint16_t),
+                   (uint64_t)value * 0x0001000100010001ull);
+  return src;
+}
+
+uint32_t * my_memset32(uint32_t * src, size_t length, uint32_t value) {
+  mem_kernels.fill((uint8_t *)src, length * sizeof(uint32_t),
+                   (uint64_t)value * 0x0000000100000001ull);
+  return src;
+}
+
+uint64_t * my_memset64(uint64_t * src, size_t length, uint64_t value) {
+  mem_kernels.fill((uint8_t *)src, length * sizeof(uint64_t), value);
+  return src;
+}
+
+uint8_t * my_memfill_pattern(uint8_t * src, size_t length, uint8_t * pattern, size_t pattern_length) {
+  uint64_t word = 0;
+  size_t block;
+  size_t filled;
+  size_t i;
+
+  if (length == 0 || pattern_length == 0) {
+    return src;
+  }
+  // patterns that tile 8 bytes are broadcast into a word
+  if (pattern_length == 1 || pattern_length == 2 || pattern_length == 4 || pattern_length == 8) {
+    for (i = 0; i < 8; i++) {
+      word |= (uint64_t)pattern[i % pattern_length] << (8 * i);
+    }
+    mem_kernels.fill(src, length, word);
+    return src;
+  }
+  // anything else is seeded once and then doubled with wide copies, up to
+  // a cache friendly block that is then repeated to the end
+  filled = (pattern_length < length) ? pattern_length : length;
+  my_memcopy(pattern, src, filled);
+  block = (MEM_FILL_BLOCK / pattern_length) * pattern_length;
+  if (block == 0) {
+    block = pattern_length;
+  }
+  while (filled < length && filled < block) {
+    size_t n = (filled < length - filled) ? filled : length - filled;
+    if (n > block - filled) {
+      n = block - filled;
+    }
+    my_memcopy(src, src + filled, n);
+    filled += n;
+  }
+  while (filled < length) {
+    size_t n = (block < length - filled) ? block : length - filled;
+    my_memcopy(src, src + filled, n);
+    filled += n;
+  }
+  return src;
+}
+
+uint8_t * my_memswap(uint8_t * src, uint8_t * dst, size_t length) {
+  // exchange the two regions in one pass, no scratch buffer needed
+  if (src != dst) {
+    mem_kernels.swap(src, dst, length);
+  }
+  return src;
+}
+
+uint8_t * my_rotate(uint8_t * src, size_t length, size_t shift) {
+  uint8_t temp[MEM_SMALL_SIZE];
+  uint8_t * p = src;
+  size_t a;
+  size_t b;
+
+  if (length == 0) {
+    return src;
+  }
+  // rotating left by shift, A = src[0, shift) and B = src[shift, length)
+  a = shift % length;
+  b = length - a;
+  while (a != 0 && b != 0) {
+    // a short side is parked on the stack while the long side moves over
+    if (a <= MEM_SMALL_SIZE) {
+      my_memcopy(p, temp, a);
+      my_memmove(p + a, p, b);
+      my_memcopy(temp, p + b, a);
+      break;
+    }
+    if (b <= MEM_SMALL_SIZE) {
+      my_memcopy(p + a, temp, b);
+      my_memmove(p, p + b, a);
+      my_memcopy(temp, p, b);
+      break;
+    }
+    // otherwise swap equal blocks, each swap puts one block in place
+    if (a <= b) {
+      my_memswap(p, p + a, a);
+      p += a;
+      b -= a;
+    } else {
+      my_memswap(p + a - b, p + a, b);
+      a -= b;
+    }
   }
-  //return src;
   return src;
 }
 
+uint8_t * my_memxlat(uint8_t * src, uint8_t * dst, size_t length, uint8_t * table) {
+  // copy and translate every byte through the table in one pass
+  mem_kernels.xlat(src, dst, length, table);
+  return dst;
+}
+
+size_t my_memcopyv(uint8_t * dst, const mem_segment_t * segs, size_t count) {
+  // kernel and write position stay in locals for the whole batch
+  void (*copy)(uint8_t * src, uint8_t * dst, size_t length) = mem_kernels.copy_forward;
+  uint8_t * out = dst;
+  size_t length;
+  size_t i;
+
+  for (i = 0; i < count; i++) {
+    length = segs[i].length;
+    if (length <= MEM_SMALL_SIZE) {
+      copy_small(segs[i].ptr, out, length);
+    } else {
+      copy(segs[i].ptr, out, length);
+    }
+    out += length;
+  }
+  return (size_t)(out - dst);
+}
+
+size_t my_memscatterv(uint8_t * src, const mem_segment_t * segs, size_t count) {
+  void (*copy)(uint8_t * src, uint8_t * dst, size_t length) = mem_kernels.copy_forward;
+  uint8_t * in = src;
+  size_t length;
+  size_t i;
+
+  for (i = 0; i < count; i++) {
+    length = segs[i].length;
+    if (length <= MEM_SMALL_SIZE) {
+      copy_small(in, segs[i].ptr, length);
+    } else {
+      copy(in, segs[i].ptr, length);
+    }
+    in += length;
+  }
+  return (size_t)(in - src);
+}
+
+/***********************************************************
+ Checksums
+***********************************************************/
+// largest run of bytes before the adler sums must be reduced
+#define ADLER32_MOD  (65521u)
+#define ADLER32_NMAX (5552u)
+
+static uint32_t adler32_copy(uint8_t * src, uint8_t * dst, size_t length, uint32_t adler) {
+  uint32_t a = adler & 0xFFFF;
+  uint32_t b = adler >> 16;
+  uint32_t w;
+  size_t run;
+
+  while (length > 0) {
+    // reduce modulo 65521 only once per run that cannot overflow
+    run = (length < ADLER32_NMAX) ? length : ADLER32_NMAX;
+    length -= run;
+    while (run >= 4) {
+      w = LOAD32(src);
+      if (dst != NULL) {
+        STORE32(dst, w);
+        dst += 4;
+      }
+      a += w & 0xFF;
+      b += a;
+      a += (w >> 8) & 0xFF;
+      b += a;
+      a += (w >> 16) & 0xFF;
+      b += a;
+      a += w >> 24;
+      b += a;
+      src += 4;
+      run -= 4;
+    }
+    while (run > 0) {
+      if (dst != NULL) {
+        *dst++ = *src;
+      }
+      a += *src++;
+      b += a;
+      run--;
+    }
+    a %= ADLER32_MOD;
+    b %= ADLER32_MOD;
+  }
+  return (b << 16) | a;
+}
+
+uint32_t my_crc32(uint8_t * src, size_t length, uint32_t crc) {
+  return crc32_update(src, length, crc);
+}
+
+uint32_t my_memcopy_crc32(uint8_t * src, uint8_t * dst, size_t length, uint32_t crc) {
+  return crc32_copy(src, dst, length, crc);
+}
+
+uint32_t my_adler32(uint8_t * src, size_t length, uint32_t adler) {
+  return adler32_copy(src, NULL, length, adler);
+}
+
+uint32_t my_memcopy_adler32(uint8_t * src, uint8_t * dst, size_t length, uint32_t adler) {
+  return adler32_copy(src, dst, length, adler);
+}
+
+/***********************************************************
+ Channel Interleaving
+***********************************************************/
+void my_deinterleave8(uint8_t * src, uint8_t ** dsts, size_t channels, size_t frames) {
+  size_t f, c;
+
+  if (channels == 1) {
+    my_memcopy(src, dsts[0], frames);
+    return;
+  }
+  f = mem_kernels.deinterleave(src, dsts, channels, frames, 1);
+  // remaining frames one sample at a time
+  for (src += f * channels; f < frames; f++) {
+    for (c = 0; c < channels; c++) {
+      dsts[c][f] = *src++;
+    }
+  }
+}
+
+void my_interleave8(uint8_t ** srcs, uint8_t * dst, size_t channels, size_t frames) {
+  size_t f, c;
+
+  if (channels == 1) {
+    my_memcopy(srcs[0], dst, frames);
+    return;
+  }
+  f = mem_kernels.interleave(srcs, dst, channels, frames, 1);
+  for (dst += f * channels; f < frames; f++) {
+    for (c = 0; c < channels; c++) {
+      *dst++ = srcs[c][f];
+    }
+  }
+}
+
+void my_deinterleave16(uint16_t * src, uint16_t ** dsts, size_t channels, size_t frames) {
+  uint8_t * planes[4];
+  size_t f = 0;
+  size_t c;
+
+  if (channels == 1) {
+    my_memcopy((uint8_t *)src, (uint8_t *)dsts[0], frames * sizeof(uint16_t));
+    return;
+  }
+  if (channels <= 4) {
+    for (c = 0; c < channels; c++) {
+      planes[c] = (uint8_t *)dsts[c];
+    }
+    f = mem_kernels.deinterleave((uint8_t *)src, planes, channels, frames, sizeof(uint16_t));
+  }
+  for (src += f * channels; f < frames; f++) {
+    for (c = 0; c < channels; c++) {
+      dsts[c][f] = *src++;
+    }
+  }
+}
+
+void my_interleave16(uint16_t ** srcs, uint16_t * dst, size_t channels, size_t frames) {
+  uint8_t * planes[4];
+  size_t f = 0;
+  size_t c;
+
+  if (channels == 1) {
+    my_memcopy((uint8_t *)srcs[0], (uint8_t *)dst, frames * sizeof(uint16_t));
+    return;
+  }
+  if (channels <= 4) {
+    for (c = 0; c < channels; c++) {
+      planes[c] = (uint8_t *)srcs[c];
+    }
+    f = mem_kernels.interleave(planes, (uint8_t *)dst, channels, frames, sizeof(uint16_t));
+  }
+  for (dst += f * channels; f < frames; f++) {
+    for (c = 0; c < channels; c++) {
+      *dst++ = srcs[c][f];
+    }
+  }
+}
+
+int32_t my_memcmp(uint8_t * src, uint8_t * dst, size_t length) {
+  // compare as unsigned bytes at the first difference
+  size_t offset = mem_kernels.diff(src, dst, length);
+
+  if (offset == length) {
+    return 0;
+  }
+  return (int32_t)src[offset] - (int32_t)dst[offset];
+}
+
+size_t my_memdiff(uint8_t * src, uint8_t * dst, size_t length) {
+  return mem_kernels.diff(src, dst, length);
+}
+
+uint8_t * my_memchr(uint8_t * src, size_t length, uint8_t value) {
+  size_t offset = mem_kernels.chr(src, length, value);
+
+  return (offset == length) ? NULL : src + offset;
+}
+
+uint8_t * my_memrchr(uint8_t * src, size_t length, uint8_t value) {
+  size_t offset = mem_kernels.rchr(src, length, value);
+
+  return (offset == length) ? NULL : src + offset;
+}
+
+/***********************************************************
+ Parallel Variants
+***********************************************************/
+// chunk boundaries fall on pages of the destination
+#define MEM_PAGE_SIZE ((uintptr_t)4096)
+
+static size_t mem_mt_threads = MEM_MT_THREADS;
+static size_t mem_mt_threshold = MEM_MT_THRESHOLD;
+
+size_t my_mem_set_threads(size_t threads) {
+  size_t previous = mem_mt_threads;
+
+  mem_mt_threads = (threads == 0) ? 1 : threads;
+  return previous;
+}
+
+size_t my_mem_set_mt_threshold(size_t threshold) {
+  size_t previous = mem_mt_threshold;
+
+  mem_mt_threshold = threshold;
+  return previous;
+}
+
+#if defined (HOST)
+typedef struct {
+  uint8_t * src;   // NULL for a set
+  uint8_t * dst;
+  size_t length;
+  uint8_t value;
+} mem_chunk_t;
+
+static void * mem_chunk_run(void * arg) {
+  mem_chunk_t * chunk = (mem_chunk_t *)arg;
+
+  if (chunk->src != NULL) {
+    my_memcopy(chunk->src, chunk->dst, chunk->length);
+  } else {
+    my_memset(chunk->dst, chunk->length, chunk->value);
+  }
+  return NULL;
+}
+
+static void mem_parallel(uint8_t * src, uint8_t * dst, size_t length, uint8_t value) {
+  mem_chunk_t chunks[MEM_MT_THREADS_MAX];
+  pthread_t threads[MEM_MT_THREADS_MAX];
+  uint8_t started[MEM_MT_THREADS_MAX];
+  size_t count = mem_mt_threads;
+  size_t start = 0;
+  size_t end;
+  size_t i;
+
+  if (count > MEM_MT_THREADS_MAX) {
+    count = MEM_MT_THREADS_MAX;
+  }
+  // split at the first page boundary past each even share of the range
+  for (i = 0; i < count; i++) {
+    end = length;
+    if (i + 1 < count) {
+      end = (size_t)((((uintptr_t)dst + length / count * (i + 1)) + MEM_PAGE_SIZE - 1)
+                     & ~(MEM_PAGE_SIZE - 1)) - (size_t)(uintptr_t)dst;
+      if (end > length) {
+        end = length;
+      }
+    }
+    chunks[i].src = (src != NULL) ? src + start : NULL;
+    chunks[i].dst = dst + start;
+    chunks[i].length = (end > start) ? end - start : 0;
+    chunks[i].value = value;
+    start = (end > start) ? end : start;
+  }
+
+  // the calling thread takes the first chunk, workers take the rest
+  for (i = 1; i < count; i++) {
+    started[i] = (pthread_create(&threads[i], NULL, mem_chunk_run, &chunks[i]) == 0);
+    if (!started[i]) {
+      mem_chunk_run(&chunks[i]);
+    }
+  }
+  mem_chunk_run(&chunks[0]);
+  // only return once every chunk has landed
+  for (i = 1; i < count; i++) {
+    if (started[i]) {
+      pthread_join(threads[i], NULL);
+    }
+  }
+}
+#endif /* HOST */
+
+uint8_t * my_memcopy_mt(uint8_t * src, uint8_t * dst, size_t length) {
+#if defined (HOST)
+  if (src != dst && mem_mt_threads > 1 && length >= mem_mt_threshold) {
+    mem_parallel(src, dst, length, 0);
+    return dst;
+  }
+#endif
+  return my_memcopy(src, dst, length);
+}
+
+uint8_t * my_memset_mt(uint8_t * src, size_t length, uint8_t value) {
+#if defined (HOST)
+  if (mem_mt_threads > 1 && length >= mem_mt_threshold) {
+    mem_parallel(NULL, src, length, value);
+    return src;
+  }
+#endif
+  return my_memset(src, length, value);
+}
+
+uint8_t * my_memzero_mt(uint8_t * src, size_t length) {
+  return my_memset_mt(src, length, 0);
+}
+
 uint8_t * my_reverse(uint8_t * src, size_t length) {
   // reverse the order of bytes from src to end of length
-  // Swap bytes in place
-  // Using a temporary variable to swap elements
-  uint8_t temp;
-
-  for (size_t i = 0; i < length / 2; i++) {
-    // store the temporary value
-    temp = *(src + i);
-    // grab the value from the end of the src and store it in the beginning
-    *(src + i) = *(src + length - i - 1);
-    // store the temporary value in the end of the src
-    *(src + length - i - 1) = temp;
+  // Swap blocks from both ends in place, reversing each block on the way
+  if (length > 1) {
+    mem_kernels.reverse(src, length);
   }
   //return src;
   return src;
 }
 
-int32_t * reserve_words(size_t length) {
+uint16_t * my_reverse16(uint16_t * src, size_t length) {
+  // reverse the order of length 16-bit elements
+  if (length > 1) {
+    mem_kernels.reverse_elems((uint8_t *)src, length, sizeof(uint16_t));
+  }
+  return src;
+}
+
+uint32_t * my_reverse32(uint32_t * src, size_t length) {
+  if (length > 1) {
+    mem_kernels.reverse_elems((uint8_t *)src, length, sizeof(uint32_t));
+  }
+  return src;
+}
+
+uint64_t * my_reverse64(uint64_t * src, size_t length) {
+  if (length > 1) {
+    mem_kernels.reverse_elems((uint8_t *)src, length, sizeof(uint64_t));
+  }
+  return src;
+}
+
+uint16_t * my_bswap16_array(uint16_t * src, size_t length) {
+  // byte swap each of length 16-bit elements in place
+  mem_kernels.bswap_elems((uint8_t *)src, length, sizeof(uint16_t));
+  return src;
+}
+
+uint32_t * my_bswap32_array(uint32_t * src, size_t length) {
+  mem_kernels.bswap_elems((uint8_t *)src, length, sizeof(uint32_t));
+  return src;
+}
+
+uint64_t * my_bswap64_array(uint64_t * src, size_t length) {
+  mem_kernels.bswap_elems((uint8_t *)src, length, sizeof(uint64_t));
+  return src;
+}
+
+/***********************************************************
+ Huge Pages
+***********************************************************/
+static size_t mem_huge_threshold = MEM_HUGE_THRESHOLD;
+static mem_alloc_stats_t mem_alloc_counts;
+
+// 64-bit atomics would need libatomic on the Cortex-M4, which has no other
+// thread to race with
+#if defined (HOST)
+#define MEM_COUNT(counter) __atomic_add_fetch(&(counter), 1, __ATOMIC_RELAXED)
+#define MEM_COUNT_READ(counter) __atomic_load_n(&(counter), __ATOMIC_RELAXED)
+#else
+#define MEM_COUNT(counter) ((counter)++)
+#define MEM_COUNT_READ(counter) (counter)
+#endif
+
+size_t my_mem_set_huge_threshold(size_t threshold) {
+  size_t previous = mem_huge_threshold;
+
+  mem_huge_threshold = threshold;
+  return previous;
+}
+
+void my_mem_alloc_stats(mem_alloc_stats_t * stats) {
+  stats->heap = MEM_COUNT_READ(mem_alloc_counts.heap);
+  stats->hugetlb = MEM_COUNT_READ(mem_alloc_counts.hugetlb);
+  stats->thp = MEM_COUNT_READ(mem_alloc_counts.thp);
+}
+
+#if defined (MEM_HUGE)
+typedef struct {
+  void * ptr;
+  size_t length;
+} mem_mapping_t;
+
+// free_words looks pointers up here, so it can tell a mapping from the heap
+static mem_mapping_t mem_mappings[MEM_HUGE_MAPPINGS];
+static size_t mem_mapping_count = 0;
+static pthread_mutex_t mem_mapping_lock = PTHREAD_MUTEX_INITIALIZER;
+
+static uint8_t mem_huge_register(void * ptr, size_t length) {
+  size_t i;
+  uint8_t ret = 0;
+
+  pthread_mutex_lock(&mem_mapping_lock);
+  for (i = 0; i < MEM_HUGE_MAPPINGS; i++) {
+    if (mem_mappings[i].ptr == NULL) {
+      mem_mappings[i].ptr = ptr;
+      mem_mappings[i].length = length;
+      __atomic_add_fetch(&mem_mapping_count, 1, __ATOMIC_RELAXED);
+      ret = 1;
+      break;
+    }
+  }
+  pthread_mutex_unlock(&mem_mapping_lock);
+  return ret;
+}
+
+// maps length bytes aligned to MEM_HUGE_PAGE_SIZE, so the kernel can back
+// every page of it with a huge page
+static void * mem_huge_map_thp(size_t length) {
+  size_t span = length + MEM_HUGE_PAGE_SIZE;
+  uint8_t * raw;
+  uint8_t * base;
+
+  raw = (uint8_t *)mmap(NULL, span, PROT_READ | PROT_WRITE, MAP_PRIVATE | MAP_ANONYMOUS, -1, 0);
+  if (raw == (uint8_t *)MAP_FAILED) {
+    return NULL;
+  }
+  base = (uint8_t *)(((uintptr_t)raw + MEM_HUGE_PAGE_SIZE - 1) & ~(uintptr_t)(MEM_HUGE_PAGE_SIZE - 1));
+  if (base > raw) {
+    munmap(raw, (size_t)(base - raw));
+  }
+  if (raw + span > base + length) {
+    munmap(base + length, (size_t)(raw + span - (base + length)));
+  }
+  // without transparent huge pages this is an ordinary mapping, leave it
+  // to the heap
+  if (madvise(base, length, MADV_HUGEPAGE) != 0) {
+    munmap(base, length);
+    return NULL;
+  }
+  return base;
+}
+
+static int32_t * mem_huge_alloc(size_t bytes) {
+  size_t length;
+  void * ptr;
+  uint8_t hugetlb = 1;
+
+  if (bytes > SIZE_MAX - MEM_HUGE_PAGE_SIZE * 2) {
+    return NULL;
+  }
+  length = (bytes + MEM_HUGE_PAGE_SIZE - 1) & ~(size_t)(MEM_HUGE_PAGE_SIZE - 1);
+  ptr = mmap(NULL, length, PROT_READ | PROT_WRITE, MAP_PRIVATE | MAP_ANONYMOUS | MAP_HUGETLB, -1, 0);
+  if (ptr == MAP_FAILED) {
+    hugetlb = 0;
+    ptr = mem_huge_map_thp(length);
+    if (ptr == NULL) {
+      return NULL;
+    }
+  }
+  if (!mem_huge_register(ptr, length)) {
+    munmap(ptr, length);
+    return NULL;
+  }
+  if (hugetlb) {
+    MEM_COUNT(mem_alloc_counts.hugetlb);
+  } else {
+    MEM_COUNT(mem_alloc_counts.thp);
+  }
+  return (int32_t *)ptr;
+}
+
+// unmaps ptr if it is a huge page mapping, returns 0 if it is not
+static uint8_t mem_huge_free(void * ptr) {
+  size_t i;
+  size_t length = 0;
+
+  // every mapping starts on a huge page, which heap and slab blocks almost
+  // never do, so nearly every call returns here without taking the lock
+  if (((uintptr_t)ptr & (MEM_HUGE_PAGE_SIZE - 1)) != 0 ||
+      __atomic_load_n(&mem_mapping_count, __ATOMIC_RELAXED) == 0) {
+    return 0;
+  }
+  pthread_mutex_lock(&mem_mapping_lock);
+  for (i = 0; i < MEM_HUGE_MAPPINGS; i++) {
+    if (mem_mappings[i].ptr == ptr) {
+      length = mem_mappings[i].length;
+      mem_mappings[i].ptr = NULL;
+      __atomic_sub_fetch(&mem_mapping_count, 1, __ATOMIC_RELAXED);
+      break;
+    }
+  }
+  pthread_mutex_unlock(&mem_mapping_lock);
+  if (length == 0) {
+    return 0;
+  }
+  munmap(ptr, length);
+  return 1;
+}
+#endif
+
+#if defined (MSP432)
+/***********************************************************
+ Heap Limit (MSP432)
+***********************************************************/
+// both from msp432p401r.lds: the end of the fixed heap sections, and the
+// lowest address the stack may reach
+extern uint8_t __heap_end__;
+extern uint8_t __StackLimit;
+
+// newlib's malloc grows its heap through _sbrk, and the one in libnosys
+// never says no; this one refuses to hand out the stack
+void * _sbrk(ptrdiff_t increment) {
+  static uint8_t * brk = &__heap_end__;
+  uint8_t * prev = brk;
+
+  if (increment > &__StackLimit - brk || increment < &__heap_end__ - brk) {
+    errno = ENOMEM;
+    return (void *)-1;
+  }
+  brk += increment;
+  return prev;
+}
+#endif
+
+// the backend chosen at build time, or malloc
+static int32_t * mem_heap_alloc(size_t length) {
+  int32_t * ptr;
+
+#if defined (MEM_ALLOC_POOL)
+  // requests larger than every block, or a pool that is used up, fall
+  // back to malloc
+  if (length <= SIZE_MAX / sizeof(int32_t)) {
+    ptr = (int32_t *)pool_alloc(length * sizeof(int32_t));
+    if (ptr != NULL) {
+      return ptr;
+    }
+  }
+#elif defined (MEM_ALLOC_SLAB)
+  if (length > SIZE_MAX / sizeof(int32_t)) {
+    return NULL;
+  }
+  return (int32_t *)slab_alloc(length * sizeof(int32_t));
+#elif defined (MEM_ALLOC_TLSF)
+  // no fallback, so every allocation has the same bound
+  if (length > SIZE_MAX / sizeof(int32_t)) {
+    return NULL;
+  }
+  return (int32_t *)tlsf_alloc(length * sizeof(int32_t));
+#endif
   // Allocate memory for an array of int32_t
-  int32_t * ptr = (int32_t *)malloc(length * sizeof(int32_t));
+  ptr = (int32_t *)malloc(length * sizeof(int32_t));
   
   // check if memory allocation was successful
   if (ptr == NULL) {
@@ -135,7 +2263,42 @@ int32_t * reserve_words(size_t length) {
   return ptr;
 }
 
+int32_t * reserve_words(size_t length) {
+  int32_t * ptr;
+
+#if defined (MEM_HUGE)
+  if (length <= SIZE_MAX / sizeof(int32_t) && length * sizeof(int32_t) > mem_huge_threshold) {
+    ptr = mem_huge_alloc(length * sizeof(int32_t));
+    if (ptr != NULL) {
+      return ptr;
+    }
+  }
+#endif
+  ptr = mem_heap_alloc(length);
+  if (ptr != NULL) {
+    MEM_COUNT(mem_alloc_counts.heap);
+  }
+  return ptr;
+}
+
 void free_words(int32_t * src) {
+#if defined (MEM_HUGE)
+  if (mem_huge_free(src)) {
+    return;
+  }
+#endif
+#if defined (MEM_ALLOC_POOL)
+  if (pool_owns(src)) {
+    pool_free(src);
+    return;
+  }
+#elif defined (MEM_ALLOC_SLAB)
+  slab_free(src);
+  return;
+#elif defined (MEM_ALLOC_TLSF)
+  tlsf_free(src);
+  return;
+#endif
   // free up the memory allocated for the int32_t array
   if (src != NULL) {
     free(src);
@@ -143,3 +2306,54 @@ void free_words(int32_t * src) {
   // No return value needed, as the function is void
   return;
 }
+
+uint8_t * reserve_bytes_aligned(size_t length, size_t alignment) {
+  void * ptr;
+
+  if (alignment == 0 || (alignment & (alignment - 1)) != 0) {
+    return NULL;
+  }
+#if defined (HOST)
+  // posix_memalign wants at least pointer alignment
+  if (alignment < sizeof(void *)) {
+    alignment = sizeof(void *);
+  }
+  if (posix_memalign(&ptr, alignment, length) != 0) {
+    return NULL;
+  }
+  return (uint8_t *)ptr;
+#else
+  uintptr_t base;
+
+  // carve an aligned block out of a larger one, with the pointer to give
+  // back to free stored just below it
+  if (length > SIZE_MAX - alignment - sizeof(void *)) {
+    return NULL;
+  }
+  ptr = malloc(length + alignment - 1 + sizeof(void *));
+  if (ptr == NULL) {
+    return NULL;
+  }
+  base = ((uintptr_t)ptr + sizeof(void *) + alignment - 1) & ~(uintptr_t)(alignment - 1);
+  ((void **)base)[-1] = ptr;
+  return (uint8_t *)base;
+#endif
+}
+
+int32_t * reserve_words_aligned(size_t length, size_t alignment) {
+  if (length > SIZE_MAX / sizeof(int32_t)) {
+    return NULL;
+  }
+  return (int32_t *)reserve_bytes_aligned(length * sizeof(int32_t), alignment);
+}
+
+void free_aligned(void * src) {
+  if (src == NULL) {
+    return;
+  }
+#if defined (HOST)
+  free(src);
+#else
+  free(((void **)src)[-1]);
+#endif
+}
@@ -0,0 +1,199 @@
+/******************************************************************************
+ * Copyright (C) 2025 by Albert Olszewski
+ *
+ * Redistribution, modification or use of this software in source or binary
+ * forms is permitted as long as the files maintain this copyright. Users are
+ * permitted to modify this and use it to learn about the field of embedded
+ * software. Alex Fosdick and the University of Colorado are not liable for any
+ * misuse of this material.
+ *
+ *****************************************************************************/
+/**
+ * @file pool.c
+ * @brief Fixed-block pool allocator
+ *
+ * One static array holds every class back to back. A free block stores the
+ * link to the next free block of its class in its first word, so the lists
+ * cost no memory beyond the blocks themselves.
+ *
+ * @author Albert Olszewski
+ * @date October 17, 2026
+ *
+ */
+#include "pool.h"
+#include <stdint.h>
+#include <stdlib.h>
+
+#if defined (MSP432)
+#include "msp432p401r.h"
+// keep the blocks inside the .heap section, see msp432p401r.lds
+#define POOL_SECTION __attribute__((section(".heap.pool")))
+#else
+#include <pthread.h>
+#define POOL_SECTION
+#endif
+
+typedef struct pool_block {
+  struct pool_block * next;
+} pool_block_t;
+
+typedef struct {
+  pool_block_t * free;
+  size_t size;
+  size_t count;
+  size_t available;
+  uint8_t * start;
+  uint8_t * end;
+} pool_class_t;
+
+#define POOL_BYTES(size, count) + (size) * (count)
+#define POOL_CLASS(size, count) { NULL, (size), (count), 0, NULL, NULL },
+
+static pool_class_t pool_classes[] = { POOL_CLASSES(POOL_CLASS) };
+static uint8_t pool_storage[0 POOL_CLASSES(POOL_BYTES)] __attribute__((aligned(8))) POOL_SECTION;
+static uint8_t pool_ready = 0;
+
+#define POOL_CLASS_COUNT (sizeof(pool_classes) / sizeof(pool_classes[0]))
+
+/***********************************************************
+ Locking
+***********************************************************/
+// the lists are shared with interrupts on MSP432 and threads on HOST
+#if defined (MSP432)
+static uint32_t pool_lock(void) {
+  uint32_t primask = __get_PRIMASK();
+
+  __disable_irq();
+  return primask;
+}
+
+static void pool_unlock(uint32_t primask) {
+  __set_PRIMASK(primask);
+}
+#else
+static pthread_mutex_t pool_mutex = PTHREAD_MUTEX_INITIALIZER;
+
+static uint32_t pool_lock(void) {
+  pthread_mutex_lock(&pool_mutex);
+  return 0;
+}
+
+static void pool_unlock(uint32_t key) {
+  (void)key;
+  pthread_mutex_unlock(&pool_mutex);
+}
+#endif
+
+/***********************************************************
+ Free Lists
+***********************************************************/
+// the caller holds the lock; the storage is not zeroed on MSP432 (NOLOAD),
+// so the lists are threaded through it at run time
+static void pool_init(void) {
+  uint8_t * block = pool_storage;
+  pool_class_t * cls;
+  pool_block_t * b;
+  size_t c, i;
+
+  for (c = 0; c < POOL_CLASS_COUNT; c++) {
+    cls = &pool_classes[c];
+    cls->start = block;
+    cls->free = NULL;
+    // push in reverse so the lowest address is handed out first
+    for (i = cls->count; i > 0; i--) {
+      b = (pool_block_t *)(block + (i - 1) * cls->size);
+      b->next = cls->free;
+      cls->free = b;
+    }
+    block += cls->size * cls->count;
+    cls->end = block;
+    cls->available = cls->count;
+  }
+  pool_ready = 1;
+}
+
+static pool_class_t * pool_class_for(size_t length) {
+  size_t c;
+
+  for (c = 0; c < POOL_CLASS_COUNT; c++) {
+    if (length <= pool_classes[c].size) {
+      return &pool_classes[c];
+    }
+  }
+  return NULL;
+}
+
+/***********************************************************
+ Function Definitions
+***********************************************************/
+void * pool_alloc(size_t length) {
+  pool_class_t * cls = pool_class_for(length);
+  pool_block_t * b = NULL;
+  uint32_t key;
+
+  if (cls == NULL) {
+    return NULL;
+  }
+  key = pool_lock();
+  if (!pool_ready) {
+    pool_init();
+  }
+  // a used up class spills into the next larger one
+  for (; cls < &pool_classes[POOL_CLASS_COUNT]; cls++) {
+    if (cls->free != NULL) {
+      b = cls->free;
+      cls->free = b->next;
+      cls->available--;
+      break;
+    }
+  }
+  pool_unlock(key);
+  return b;
+}
+
+void pool_free(void * ptr) {
+  pool_class_t * cls;
+  pool_block_t * b = (pool_block_t *)ptr;
+  uint32_t key;
+
+  if (ptr == NULL) {
+    return;
+  }
+  for (cls = pool_classes; cls < &pool_classes[POOL_CLASS_COUNT]; cls++) {
+    if ((uint8_t *)ptr >= cls->start && (uint8_t *)ptr < cls->end) {
+      key = pool_lock();
+      b->next = cls->free;
+      cls->free = b;
+      cls->available++;
+      pool_unlock(key);
+      return;
+    }
+  }
+}
+
+uint8_t pool_owns(void * ptr) {
+  return (uint8_t *)ptr >= pool_storage && (uint8_t *)ptr < pool_storage + sizeof(pool_storage);
+}
+
+size_t pool_block_size(size_t length) {
+  pool_class_t * cls = pool_class_for(length);
+
+  return (cls == NULL) ? 0 : cls->size;
+}
+
+size_t pool_available(size_t length) {
+  pool_class_t * cls = pool_class_for(length);
+  size_t available;
+  uint32_t key;
+
+  if (cls == NULL) {
+    return 0;
+  }
+  key = pool_lock();
+  if (!pool_ready) {
+    pool_init();
+  }
+  available = cls->available;
+  pool_unlock(key);
+  return available;
+}
@@ -0,0 +1,351 @@
+/******************************************************************************
+ * Copyright (C) 2025 by Albert Olszewski
+ *
+ * Redistribution, modification or use of this software in source or binary
+ * forms is permitted as long as the files maintain this copyright. Users are
+ * permitted to modify this and use it to learn about the field of embedded
+ * software. Alex Fosdick and the University of Colorado are not liable for any
+ * misuse of this material.
+ *
+ *****************************************************************************/
+/**
+ * @file slab.c
+ * @brief Size-class slab allocator with per-thread caches (HOST)
+ *
+ * Magazine layer after Bonwick and Adams: each thread holds a loaded and a
+ * previous magazine per class and only goes to the depot, under its lock,
+ * when both are empty (allocating) or both are full (freeing). Slabs are
+ * SLAB_SIZE aligned, so the header that names an object's class is found
+ * by masking the object's address; direct mappings carry the same header.
+ *
+ * @author Albert Olszewski
+ * @date October 17, 2026
+ *
+ */
+// mmap and MAP_ANONYMOUS are not C99
+#define _GNU_SOURCE
+
+#include "slab.h"
+#include <stdint.h>
+#include <stdlib.h>
+#include <pthread.h>
+#include <sys/mman.h>
+
+#define SLAB_MAGIC  (0x51AB51ABu)
+#define SLAB_LARGE  (0xFFFFFFFFu)
+#define SLAB_HEADER (64)
+
+// mappings are rounded to this, a multiple of every common page size
+#define SLAB_MAP_GRAIN ((size_t)64 * 1024)
+
+typedef struct {
+  uint32_t magic;
+  uint32_t cls;
+  size_t mapped;
+} slab_header_t;
+
+typedef struct slab_magazine {
+  struct slab_magazine * next;
+  uint32_t count;
+  void * objs[SLAB_MAG_SIZE];
+} slab_magazine_t;
+
+// objects on the loose list store the link in their first word
+typedef struct slab_object {
+  struct slab_object * next;
+} slab_object_t;
+
+typedef struct {
+  pthread_mutex_t lock;
+  slab_magazine_t * full;
+  slab_magazine_t * empty;
+  slab_object_t * loose;
+  uint8_t * carve;
+  uint8_t * carve_end;
+} slab_depot_t;
+
+typedef struct {
+  slab_magazine_t * loaded;
+  slab_magazine_t * previous;
+} slab_cache_t;
+
+static slab_depot_t slab_depots[SLAB_CLASSES];
+static pthread_once_t slab_once = PTHREAD_ONCE_INIT;
+static pthread_key_t slab_key;
+
+static __thread slab_cache_t slab_caches[SLAB_CLASSES];
+static __thread uint8_t slab_registered = 0;
+
+/***********************************************************
+ Mappings
+***********************************************************/
+// maps length bytes (a multiple of SLAB_MAP_GRAIN) aligned to SLAB_SIZE by
+// over-mapping and trimming both ends
+static uint8_t * slab_map(size_t length) {
+  size_t span = length + SLAB_SIZE;
+  uint8_t * raw;
+  uint8_t * base;
+
+  raw = (uint8_t *)mmap(NULL, span, PROT_READ | PROT_WRITE, MAP_PRIVATE | MAP_ANONYMOUS, -1, 0);
+  if (raw == (uint8_t *)MAP_FAILED) {
+    return NULL;
+  }
+  base = (uint8_t *)(((uintptr_t)raw + SLAB_SIZE - 1) & ~(uintptr_t)(SLAB_SIZE - 1));
+  if (base > raw) {
+    munmap(raw, (size_t)(base - raw));
+  }
+  if (raw + span > base + length) {
+    munmap(base + length, (size_t)(raw + span - (base + length)));
+  }
+  return base;
+}
+
+static void * slab_alloc_large(size_t length) {
+  slab_header_t * h;
+  size_t mapped;
+
+  if (length > SIZE_MAX - SLAB_HEADER - SLAB_MAP_GRAIN - SLAB_SIZE) {
+    return NULL;
+  }
+  mapped = (length + SLAB_HEADER + SLAB_MAP_GRAIN - 1) & ~(SLAB_MAP_GRAIN - 1);
+  h = (slab_header_t *)slab_map(mapped);
+  if (h == NULL) {
+    return NULL;
+  }
+  h->magic = SLAB_MAGIC;
+  h->cls = SLAB_LARGE;
+  h->mapped = mapped;
+  return (uint8_t *)h + SLAB_HEADER;
+}
+
+/***********************************************************
+ Depot
+***********************************************************/
+static void slab_thread_exit(void * arg);
+
+static void slab_init(void) {
+  size_t c;
+
+  for (c = 0; c < SLAB_CLASSES; c++) {
+    pthread_mutex_init(&slab_depots[c].lock, NULL);
+  }
+  pthread_key_create(&slab_key, slab_thread_exit);
+}
+
+// the caller holds the depot lock
+static slab_magazine_t * slab_magazine_take(slab_depot_t * depot) {
+  slab_magazine_t * m = depot->empty;
+
+  if (m != NULL) {
+    depot->empty = m->next;
+    return m;
+  }
+  return (slab_magazine_t *)calloc(1, sizeof(slab_magazine_t));
+}
+
+// the caller holds the depot lock
+static void slab_magazine_give(slab_depot_t * depot, slab_magazine_t * m) {
+  if (m->count > 0) {
+    m->next = depot->full;
+    depot->full = m;
+  } else {
+    m->next = depot->empty;
+    depot->empty = m;
+  }
+}
+
+// fills an empty magazine from loose objects, then from the newest slab,
+// mapping a new one when it runs out; the caller holds the depot lock
+static void slab_fill(slab_depot_t * depot, uint32_t cls, slab_magazine_t * m) {
+  size_t size = (size_t)1 << (cls + SLAB_MIN_SHIFT);
+  slab_header_t * h;
+
+  while (m->count < SLAB_MAG_SIZE && depot->loose != NULL) {
+    m->objs[m->count++] = depot->loose;
+    depot->loose = depot->loose->next;
+  }
+  while (m->count < SLAB_MAG_SIZE) {
+    if (depot->carve == depot->carve_end) {
+      h = (slab_header_t *)slab_map(SLAB_SIZE);
+      if (h == NULL) {
+        return;
+      }
+      h->magic = SLAB_MAGIC;
+      h->cls = cls;
+      h->mapped = SLAB_SIZE;
+      // objects start on a multiple of their size, clear of the header
+      depot->carve = (uint8_t *)h + ((size > SLAB_HEADER) ? size : SLAB_HEADER);
+      depot->carve_end = (uint8_t *)h + SLAB_SIZE;
+    }
+    m->objs[m->count++] = depot->carve;
+    depot->carve += size;
+  }
+}
+
+// hands a thread's magazines to the depots when it exits
+static void slab_thread_exit(void * arg) {
+  slab_cache_t * caches = (slab_cache_t *)arg;
+  size_t c;
+
+  for (c = 0; c < SLAB_CLASSES; c++) {
+    if (caches[c].loaded == NULL) {
+      continue;
+    }
+    pthread_mutex_lock(&slab_depots[c].lock);
+    slab_magazine_give(&slab_depots[c], caches[c].loaded);
+    slab_magazine_give(&slab_depots[c], caches[c].previous);
+    pthread_mutex_unlock(&slab_depots[c].lock);
+    caches[c].loaded = NULL;
+    caches[c].previous = NULL;
+  }
+}
+
+// gives the thread a pair of empty magazines for a class
+static uint8_t slab_cache_init(uint32_t cls) {
+  slab_cache_t * cache = &slab_caches[cls];
+  slab_depot_t * depot = &slab_depots[cls];
+
+  if (!slab_registered) {
+    pthread_setspecific(slab_key, slab_caches);
+    slab_registered = 1;
+  }
+  pthread_mutex_lock(&depot->lock);
+  cache->loaded = slab_magazine_take(depot);
+  cache->previous = slab_magazine_take(depot);
+  if (cache->loaded == NULL || cache->previous == NULL) {
+    if (cache->loaded != NULL) {
+      slab_magazine_give(depot, cache->loaded);
+    }
+    if (cache->previous != NULL) {
+      slab_magazine_give(depot, cache->previous);
+    }
+    cache->loaded = NULL;
+    cache->previous = NULL;
+  }
+  pthread_mutex_unlock(&depot->lock);
+  return cache->loaded != NULL;
+}
+
+static uint32_t slab_class(size_t length) {
+  uint32_t cls = 0;
+
+  while (((size_t)1 << (cls + SLAB_MIN_SHIFT)) < length) {
+    cls++;
+  }
+  return cls;
+}
+
+/***********************************************************
+ Function Definitions
+***********************************************************/
+void * slab_alloc(size_t length) {
+  slab_cache_t * cache;
+  slab_depot_t * depot;
+  slab_magazine_t * m;
+  uint32_t cls;
+
+  if (length > ((size_t)1 << SLAB_MAX_SHIFT)) {
+    return slab_alloc_large(length);
+  }
+  pthread_once(&slab_once, slab_init);
+  cls = slab_class(length);
+  cache = &slab_caches[cls];
+
+  // no lock on the common path, the magazines belong to this thread
+  if (cache->loaded != NULL && cache->loaded->count > 0) {
+    return cache->loaded->objs[--cache->loaded->count];
+  }
+  if (cache->loaded == NULL && !slab_cache_init(cls)) {
+    return NULL;
+  }
+  if (cache->previous->count > 0) {
+    m = cache->loaded;
+    cache->loaded = cache->previous;
+    cache->previous = m;
+    return cache->loaded->objs[--cache->loaded->count];
+  }
+
+  // both empty: trade the spare for a full magazine, or fill one
+  depot = &slab_depots[cls];
+  pthread_mutex_lock(&depot->lock);
+  if (depot->full != NULL) {
+    m = depot->full;
+    depot->full = m->next;
+    slab_magazine_give(depot, cache->previous);
+    cache->previous = cache->loaded;
+    cache->loaded = m;
+  } else {
+    slab_fill(depot, cls, cache->loaded);
+  }
+  pthread_mutex_unlock(&depot->lock);
+
+  if (cache->loaded->count == 0) {
+    return NULL;
+  }
+  return cache->loaded->objs[--cache->loaded->count];
+}
+
+void slab_free(void * ptr) {
+  slab_header_t * h;
+  slab_cache_t * cache;
+  slab_depot_t * depot;
+  slab_magazine_t * m;
+  slab_object_t * o;
+  uint32_t cls;
+
+  if (ptr == NULL) {
+    return;
+  }
+  h = (slab_header_t *)((uintptr_t)ptr & ~(uintptr_t)(SLAB_SIZE - 1));
+  if (h->cls == SLAB_LARGE) {
+    munmap(h, h->mapped);
+    return;
+  }
+  cls = h->cls;
+  cache = &slab_caches[cls];
+
+  if (cache->loaded != NULL && cache->loaded->count < SLAB_MAG_SIZE) {
+    cache->loaded->objs[cache->loaded->count++] = ptr;
+    return;
+  }
+  if (cache->loaded != NULL && cache->previous->count < SLAB_MAG_SIZE) {
+    m = cache->loaded;
+    cache->loaded = cache->previous;
+    cache->previous = m;
+    cache->loaded->objs[cache->loaded->count++] = ptr;
+    return;
+  }
+
+  // both full (or no cache yet): trade the spare for an empty magazine
+  depot = &slab_depots[cls];
+  if (cache->loaded != NULL) {
+    pthread_mutex_lock(&depot->lock);
+    m = slab_magazine_take(depot);
+    if (m != NULL) {
+      slab_magazine_give(depot, cache->previous);
+      cache->previous = cache->loaded;
+      cache->loaded = m;
+      cache->loaded->objs[cache->loaded->count++] = ptr;
+      pthread_mutex_unlock(&depot->lock);
+      return;
+    }
+    pthread_mutex_unlock(&depot->lock);
+  } else if (slab_cache_init(cls)) {
+    cache->loaded->objs[cache->loaded->count++] = ptr;
+    return;
+  }
+
+  // no magazine to be had, keep the object on the depot's loose list
+  o = (slab_object_t *)ptr;
+  pthread_mutex_lock(&depot->lock);
+  o->next = depot->loose;
+  depot->loose = o;
+  pthread_mutex_unlock(&depot->lock);
+}
+
+size_t slab_class_size(size_t length) {
+  if (length > ((size_t)1 << SLAB_MAX_SHIFT)) {
+    return 0;
+  }
+  return (size_t)1 << (slab_class(length) + SLAB_MIN_SHIFT);
+}
@@ -91,12 +91,15 @@ extern void PORT4_IRQHandler(void);
 extern void PORT5_IRQHandler(void);
 extern void PORT6_IRQHandler(void);
 
+/* Top of SRAM, where the stack starts, from the linker script */
+extern uint32_t __StackTop;
+
 /* Interrupt vector table.  Note that the proper constructs must be placed on this to */
 /* ensure that it ends up at physical address 0x0000.0000 or at the start of          */
 /* the program if located at a start address other than 0.                            */
 void (* const interruptVectors[])(void) __attribute__ ((section (".intvecs"))) =
 {
-    (void (*)(void))((uint32_t)0x20004000),
+    (void (*)(void))((uint32_t)&__StackTop),
                                             /* The initial stack pointer */
     &Reset_Handler,                         /* The reset handler         */
     &NMI_Handler,                           /* The NMI handler           */
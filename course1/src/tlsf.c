@@ -0,0 +1,342 @@
+/******************************************************************************
+ * Copyright (C) 2025 by Albert Olszewski
+ *
+ * Redistribution, modification or use of this software in source or binary
+ * forms is permitted as long as the files maintain this copyright. Users are
+ * permitted to modify this and use it to learn about the field of embedded
+ * software. Alex Fosdick and the University of Colorado are not liable for any
+ * misuse of this material.
+ *
+ *****************************************************************************/
+/**
+ * @file tlsf.c
+ * @brief Two-Level Segregated Fit allocator with bounded latency
+ *
+ * After Masmano et al. Every block starts with a header holding the block
+ * before it and its own size, with bit 0 of the size set while the block
+ * is free. Free blocks keep their list links in what would be the payload.
+ * A zero sized block that is never free ends the heap, so the block after
+ * any other block always exists.
+ *
+ * @author Albert Olszewski
+ * @date October 17, 2026
+ *
+ */
+#include "tlsf.h"
+#include <stddef.h>
+#include <stdint.h>
+#include <stdlib.h>
+
+#if defined (MSP432)
+#include "msp432p401r.h"
+// __CLZ is the Cortex-M4 clz instruction, from cmsis_gcc.h
+#define TLSF_CLZ(x)  __CLZ(x)
+// keep the heap inside the .heap section, see msp432p401r.lds
+#define TLSF_SECTION __attribute__((section(".heap.tlsf")))
+#else
+#include <pthread.h>
+#define TLSF_CLZ(x)  __builtin_clz(x)
+#define TLSF_SECTION
+#endif
+
+#define TLSF_ALIGN_SHIFT (3)
+#define TLSF_ALIGN       (1u << TLSF_ALIGN_SHIFT)
+#define TLSF_SL_COUNT    (1u << TLSF_SL_LOG2)
+// below this every size has its own second level list
+#define TLSF_FL_SHIFT    (TLSF_SL_LOG2 + TLSF_ALIGN_SHIFT)
+#define TLSF_SMALL       ((size_t)1 << TLSF_FL_SHIFT)
+#define TLSF_FL_COUNT    (TLSF_FL_MAX - TLSF_FL_SHIFT + 1)
+
+#define TLSF_FREE        ((size_t)1)
+
+typedef struct tlsf_block {
+  struct tlsf_block * prev_phys;
+  size_t size;
+  // only while the block is free
+  struct tlsf_block * next_free;
+  struct tlsf_block * prev_free;
+} tlsf_block_t;
+
+#define TLSF_HEADER      (offsetof(tlsf_block_t, next_free))
+#define TLSF_MIN_PAYLOAD (sizeof(tlsf_block_t) - TLSF_HEADER)
+
+static uint8_t tlsf_storage[TLSF_HEAP_SIZE] __attribute__((aligned(8))) TLSF_SECTION;
+static tlsf_block_t * tlsf_heads[TLSF_FL_COUNT][TLSF_SL_COUNT];
+static uint32_t tlsf_sl_bitmap[TLSF_FL_COUNT];
+static uint32_t tlsf_fl_bitmap = 0;
+static uint8_t tlsf_ready = 0;
+
+/***********************************************************
+ Locking
+***********************************************************/
+#if defined (MSP432)
+static uint32_t tlsf_lock(void) {
+  uint32_t primask = __get_PRIMASK();
+
+  __disable_irq();
+  return primask;
+}
+
+static void tlsf_unlock(uint32_t primask) {
+  __set_PRIMASK(primask);
+}
+#else
+static pthread_mutex_t tlsf_mutex = PTHREAD_MUTEX_INITIALIZER;
+
+static uint32_t tlsf_lock(void) {
+  pthread_mutex_lock(&tlsf_mutex);
+  return 0;
+}
+
+static void tlsf_unlock(uint32_t key) {
+  (void)key;
+  pthread_mutex_unlock(&tlsf_mutex);
+}
+#endif
+
+/***********************************************************
+ Size Mapping
+***********************************************************/
+// index of the highest and lowest set bit, x must not be 0
+static inline uint32_t tlsf_fls(uint32_t x) {
+  return 31u - (uint32_t)TLSF_CLZ(x);
+}
+
+static inline uint32_t tlsf_ffs(uint32_t x) {
+  return tlsf_fls(x & (~x + 1u));
+}
+
+static inline size_t tlsf_size(const tlsf_block_t * b) {
+  return b->size & ~TLSF_FREE;
+}
+
+static inline tlsf_block_t * tlsf_next(const tlsf_block_t * b) {
+  return (tlsf_block_t *)((uint8_t *)b + TLSF_HEADER + tlsf_size(b));
+}
+
+// the list a block of this size is filed in
+static void tlsf_mapping(size_t size, uint32_t * fl, uint32_t * sl) {
+  uint32_t f;
+
+  if (size < TLSF_SMALL) {
+    *fl = 0;
+    *sl = (uint32_t)(size >> TLSF_ALIGN_SHIFT);
+  } else {
+    f = tlsf_fls((uint32_t)size);
+    *sl = (uint32_t)(size >> (f - TLSF_SL_LOG2)) ^ TLSF_SL_COUNT;
+    *fl = f - (TLSF_FL_SHIFT - 1);
+  }
+}
+
+// the first list whose every block is at least this size
+static void tlsf_mapping_search(size_t size, uint32_t * fl, uint32_t * sl) {
+  if (size >= TLSF_SMALL) {
+    size += ((size_t)1 << (tlsf_fls((uint32_t)size) - TLSF_SL_LOG2)) - 1;
+  }
+  tlsf_mapping(size, fl, sl);
+}
+
+/***********************************************************
+ Free Lists
+***********************************************************/
+static void tlsf_insert(tlsf_block_t * b) {
+  uint32_t fl, sl;
+
+  tlsf_mapping(tlsf_size(b), &fl, &sl);
+  b->size |= TLSF_FREE;
+  b->prev_free = NULL;
+  b->next_free = tlsf_heads[fl][sl];
+  if (b->next_free != NULL) {
+    b->next_free->prev_free = b;
+  }
+  tlsf_heads[fl][sl] = b;
+  tlsf_sl_bitmap[fl] |= 1u << sl;
+  tlsf_fl_bitmap |= 1u << fl;
+}
+
+static void tlsf_remove(tlsf_block_t * b) {
+  uint32_t fl, sl;
+
+  tlsf_mapping(tlsf_size(b), &fl, &sl);
+  if (b->prev_free != NULL) {
+    b->prev_free->next_free = b->next_free;
+  } else {
+    tlsf_heads[fl][sl] = b->next_free;
+  }
+  if (b->next_free != NULL) {
+    b->next_free->prev_free = b->prev_free;
+  }
+  if (tlsf_heads[fl][sl] == NULL) {
+    tlsf_sl_bitmap[fl] &= ~(1u << sl);
+    if (tlsf_sl_bitmap[fl] == 0) {
+      tlsf_fl_bitmap &= ~(1u << fl);
+    }
+  }
+  b->size &= ~TLSF_FREE;
+}
+
+// head of the first non-empty list at or above (fl, sl), two bit scans
+static tlsf_block_t * tlsf_find(uint32_t fl, uint32_t sl) {
+  uint32_t sl_map = tlsf_sl_bitmap[fl] & (~0u << sl);
+  uint32_t fl_map;
+
+  if (sl_map == 0) {
+    fl_map = (fl + 1 < 32) ? tlsf_fl_bitmap & (~0u << (fl + 1)) : 0;
+    if (fl_map == 0) {
+      return NULL;
+    }
+    fl = tlsf_ffs(fl_map);
+    sl_map = tlsf_sl_bitmap[fl];
+  }
+  return tlsf_heads[fl][tlsf_ffs(sl_map)];
+}
+
+// one free block spanning the heap, then the end marker, which is given
+// room for a whole tlsf_block_t so it is never partly outside the array
+static void tlsf_init(void) {
+  tlsf_block_t * first = (tlsf_block_t *)tlsf_storage;
+  tlsf_block_t * last;
+
+  first->prev_phys = NULL;
+  first->size = TLSF_HEAP_SIZE - TLSF_HEADER - sizeof(tlsf_block_t);
+  last = tlsf_next(first);
+  last->prev_phys = first;
+  last->size = 0;
+  tlsf_insert(first);
+  tlsf_ready = 1;
+}
+
+/***********************************************************
+ Function Definitions
+***********************************************************/
+void * tlsf_alloc(size_t length) {
+  tlsf_block_t * b;
+  tlsf_block_t * rest;
+  size_t size;
+  uint32_t fl, sl;
+  uint32_t key;
+
+  if (length > TLSF_HEAP_SIZE) {
+    return NULL;
+  }
+  size = (length + TLSF_ALIGN - 1) & ~(size_t)(TLSF_ALIGN - 1);
+  if (size < TLSF_MIN_PAYLOAD) {
+    size = TLSF_MIN_PAYLOAD;
+  }
+  tlsf_mapping_search(size, &fl, &sl);
+  if (fl >= TLSF_FL_COUNT) {
+    return NULL;
+  }
+
+  key = tlsf_lock();
+  if (!tlsf_ready) {
+    tlsf_init();
+  }
+  b = tlsf_find(fl, sl);
+  if (b == NULL) {
+    tlsf_unlock(key);
+    return NULL;
+  }
+  tlsf_remove(b);
+
+  // give back what is left when it can stand as a block of its own
+  if (tlsf_size(b) >= size + TLSF_HEADER + TLSF_MIN_PAYLOAD) {
+    rest = (tlsf_block_t *)((uint8_t *)b + TLSF_HEADER + size);
+    rest->prev_phys = b;
+    rest->size = tlsf_size(b) - size - TLSF_HEADER;
+    tlsf_next(rest)->prev_phys = rest;
+    b->size = size;
+    tlsf_insert(rest);
+  }
+  tlsf_unlock(key);
+  return (uint8_t *)b + TLSF_HEADER;
+}
+
+void tlsf_free(void * ptr) {
+  tlsf_block_t * b;
+  tlsf_block_t * neighbour;
+  uint32_t key;
+
+  if (ptr == NULL) {
+    return;
+  }
+  b = (tlsf_block_t *)((uint8_t *)ptr - TLSF_HEADER);
+  key = tlsf_lock();
+
+  // merge with the blocks on either side while they are free
+  neighbour = b->prev_phys;
+  if (neighbour != NULL && (neighbour->size & TLSF_FREE)) {
+    tlsf_remove(neighbour);
+    neighbour->size += TLSF_HEADER + tlsf_size(b);
+    b = neighbour;
+  }
+  neighbour = tlsf_next(b);
+  if (neighbour->size & TLSF_FREE) {
+    tlsf_remove(neighbour);
+    b->size += TLSF_HEADER + tlsf_size(neighbour);
+  }
+  tlsf_next(b)->prev_phys = b;
+  tlsf_insert(b);
+  tlsf_unlock(key);
+}
+
+uint8_t tlsf_owns(void * ptr) {
+  return (uint8_t *)ptr >= tlsf_storage && (uint8_t *)ptr < tlsf_storage + TLSF_HEAP_SIZE;
+}
+
+int32_t tlsf_check(void) {
+  tlsf_block_t * b;
+  tlsf_block_t * prev = NULL;
+  tlsf_block_t * f;
+  uint32_t fl, sl;
+  int32_t free_blocks = 0;
+  int32_t listed = 0;
+  int32_t ret;
+  uint32_t key;
+
+  key = tlsf_lock();
+  if (!tlsf_ready) {
+    tlsf_init();
+  }
+  for (b = (tlsf_block_t *)tlsf_storage; ; b = tlsf_next(b)) {
+    if ((uint8_t *)b < tlsf_storage || (uint8_t *)b + TLSF_HEADER > tlsf_storage + TLSF_HEAP_SIZE ||
+        b->prev_phys != prev) {
+      tlsf_unlock(key);
+      return -1;
+    }
+    if (tlsf_size(b) == 0) {
+      break;
+    }
+    if (b->size & TLSF_FREE) {
+      if (prev != NULL && (prev->size & TLSF_FREE)) {
+        tlsf_unlock(key);
+        return -1;
+      }
+      // it must be on the list for its size
+      tlsf_mapping(tlsf_size(b), &fl, &sl);
+      for (f = tlsf_heads[fl][sl]; f != NULL && f != b; f = f->next_free) {
+      }
+      if (f == NULL) {
+        tlsf_unlock(key);
+        return -1;
+      }
+      free_blocks++;
+    }
+    prev = b;
+  }
+
+  // and the lists hold nothing else
+  for (fl = 0; fl < TLSF_FL_COUNT; fl++) {
+    for (sl = 0; sl < TLSF_SL_COUNT; sl++) {
+      for (f = tlsf_heads[fl][sl]; f != NULL; f = f->next_free) {
+        listed++;
+      }
+      if ((tlsf_heads[fl][sl] != NULL) != ((tlsf_sl_bitmap[fl] >> sl) & 1u)) {
+        listed = -1;
+      }
+    }
+  }
+  ret = (listed == free_blocks) ? free_blocks : -1;
+  tlsf_unlock(key);
+  return ret;
+}